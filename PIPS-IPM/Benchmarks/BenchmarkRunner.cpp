@@ -0,0 +1,169 @@
+#include "BenchmarkRunner.hpp"
+#include "pipsdef.h"
+
+#include <cassert>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+   std::string json_escape(const std::string& str) {
+      std::string escaped;
+      escaped.reserve(str.size());
+      for (const char c : str) {
+         if (c == '"' || c == '\\')
+            escaped.push_back('\\');
+         escaped.push_back(c);
+      }
+      return escaped;
+   }
+
+   int n_threads() {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+   }
+}
+
+BenchmarkRunner::BenchmarkRunner(MPI_Comm comm, int repetitions, int warmup, std::string filter) : comm{comm}, repetitions{repetitions}, warmup{warmup},
+   filter{std::move(filter)} {
+   assert(repetitions > 0);
+   assert(warmup >= 0);
+}
+
+bool BenchmarkRunner::enabled(const std::string& name) const {
+   return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+bool BenchmarkRunner::any_enabled(const std::vector<std::string>& names) const {
+   return std::any_of(names.begin(), names.end(), [this](const std::string& name) { return enabled(name); });
+}
+
+void BenchmarkRunner::run(const std::string& name, std::vector<std::pair<std::string, double>> parameters, double work, const std::string& work_unit,
+   const std::function<void()>& kernel, const std::function<void()>& setup) {
+   if (!enabled(name))
+      return;
+
+   const int reps = repetitions;
+
+   for (int i = 0; i < warmup; ++i) {
+      if (setup)
+         setup();
+      kernel();
+   }
+
+   std::vector<double> times(reps);
+   for (int i = 0; i < reps; ++i) {
+      if (setup)
+         setup();
+
+      MPI_Barrier(comm);
+      const double t_start = MPI_Wtime();
+      kernel();
+      times[i] = MPI_Wtime() - t_start;
+   }
+
+   /* a repetition takes as long as the slowest rank */
+   PIPS_MPImaxArrayInPlace(times, comm);
+   std::sort(times.begin(), times.end());
+
+   BenchmarkResult result;
+   result.name = name;
+   result.parameters = std::move(parameters);
+   result.repetitions = reps;
+   result.time_min = times.front();
+   result.time_max = times.back();
+   result.time_median = (reps % 2 == 1) ? times[reps / 2] : 0.5 * (times[reps / 2 - 1] + times[reps / 2]);
+   result.work = work;
+   result.work_unit = work_unit;
+
+   results_.push_back(std::move(result));
+}
+
+void BenchmarkRunner::skip(const std::string& name, const std::string& reason) {
+   if (!enabled(name))
+      return;
+
+   BenchmarkResult result;
+   result.name = name;
+   result.skipped = true;
+   result.skip_reason = reason;
+   results_.push_back(std::move(result));
+}
+
+void BenchmarkRunner::add_parameter_to_last(const std::string& parameter, double value) {
+   if (!results_.empty())
+      results_.back().parameters.emplace_back(parameter, value);
+}
+
+void BenchmarkRunner::write_json(std::ostream& out) const {
+   const auto precision = out.precision();
+   out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+   out << "{\n";
+   out << "  \"mpi_ranks\": " << PIPS_MPIgetSize(comm) << ",\n";
+   out << "  \"omp_threads\": " << n_threads() << ",\n";
+   out << "  \"warmup\": " << warmup << ",\n";
+   out << "  \"benchmarks\": [";
+
+   for (size_t i = 0; i < results_.size(); ++i) {
+      const BenchmarkResult& result = results_[i];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"name\": \"" << json_escape(result.name) << "\"";
+
+      if (result.skipped) {
+         out << ", \"skipped\": true, \"reason\": \"" << json_escape(result.skip_reason) << "\"}";
+         continue;
+      }
+
+      out << ", \"parameters\": {";
+      for (size_t j = 0; j < result.parameters.size(); ++j)
+         out << (j == 0 ? "" : ", ") << "\"" << json_escape(result.parameters[j].first) << "\": " << result.parameters[j].second;
+      out << "}";
+
+      out << ", \"repetitions\": " << result.repetitions << ", \"time_min\": " << result.time_min << ", \"time_median\": " << result.time_median
+         << ", \"time_max\": " << result.time_max;
+
+      if (result.work > 0.0 && result.time_median > 0.0)
+         out << ", \"work\": " << result.work << ", \"work_unit\": \"" << json_escape(result.work_unit) << "\", \"rate_median\": "
+            << result.work / result.time_median;
+      out << "}";
+   }
+
+   out << "\n  ]\n}\n";
+   out << std::setprecision(precision);
+}
+
+void BenchmarkRunner::print_summary(std::ostream& out) const {
+   const std::ios_base::fmtflags flags = out.flags();
+   const auto precision = out.precision();
+
+   out << std::left << std::setw(36) << "benchmark" << std::right << std::setw(14) << "median [s]" << std::setw(14) << "min [s]" << std::setw(14)
+      << "max [s]" << std::setw(18) << "rate" << "\n";
+
+   for (const BenchmarkResult& result : results_) {
+      out << std::left << std::setw(36) << result.name << std::right;
+      if (result.skipped) {
+         out << "  skipped: " << result.skip_reason << "\n";
+         continue;
+      }
+
+      out << std::scientific << std::setprecision(3) << std::setw(14) << result.time_median << std::setw(14) << result.time_min << std::setw(14)
+         << result.time_max;
+
+      if (result.work > 0.0 && result.time_median > 0.0) {
+         const double giga_rate = 1e-9 * result.work / result.time_median;
+         out << std::fixed << std::setprecision(2) << std::setw(12) << giga_rate << " G" << result.work_unit << "/s";
+      }
+      out << "\n";
+   }
+
+   out.flags(flags);
+   out << std::setprecision(precision);
+}
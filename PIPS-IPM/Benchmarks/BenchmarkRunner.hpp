@@ -0,0 +1,74 @@
+#ifndef PIPSIPMPP_BENCHMARKRUNNER_HPP
+#define PIPSIPMPP_BENCHMARKRUNNER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// save diagnostic state
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+
+#include "mpi.h"
+// turn the warnings back on
+#pragma GCC diagnostic pop
+
+/** result of a single benchmark - all timings are in seconds and taken as the maximum over all ranks per repetition */
+struct BenchmarkResult {
+   std::string name;
+   std::vector<std::pair<std::string, double>> parameters;
+
+   int repetitions{0};
+   double time_min{0.0};
+   double time_median{0.0};
+   double time_max{0.0};
+
+   /* work done per repetition in work_unit (flop or byte) - used to derive a rate; 0 if no rate is meaningful */
+   double work{0.0};
+   std::string work_unit;
+
+   bool skipped{false};
+   std::string skip_reason;
+};
+
+/**
+ * Times kernels collectively on a communicator and collects the results in a machine readable form (JSON).
+ * Every rank has to call run/skip for the same benchmarks in the same order.
+ */
+class BenchmarkRunner {
+public:
+   BenchmarkRunner(MPI_Comm comm, int repetitions, int warmup, std::string filter);
+
+   /** does the benchmark name match the filter given on the command line */
+   [[nodiscard]] bool enabled(const std::string& name) const;
+
+   /** is any of the names enabled - used to skip the setup of a group of benchmarks */
+   [[nodiscard]] bool any_enabled(const std::vector<std::string>& names) const;
+
+   /** time kernel repetitions times after warmup untimed calls; setup is called untimed before every call of kernel */
+   void run(const std::string& name, std::vector<std::pair<std::string, double>> parameters, double work, const std::string& work_unit,
+      const std::function<void()>& kernel, const std::function<void()>& setup = {});
+
+   void skip(const std::string& name, const std::string& reason);
+
+   /** attach an additional parameter (e.g. an iteration count only known after the run) to the last recorded benchmark */
+   void add_parameter_to_last(const std::string& parameter, double value);
+
+   [[nodiscard]] const std::vector<BenchmarkResult>& results() const { return results_; };
+
+   void write_json(std::ostream& out) const;
+   void print_summary(std::ostream& out) const;
+
+private:
+   MPI_Comm comm;
+   const int repetitions;
+   const int warmup;
+   const std::string filter;
+
+   std::vector<BenchmarkResult> results_;
+};
+
+#endif //PIPSIPMPP_BENCHMARKRUNNER_HPP
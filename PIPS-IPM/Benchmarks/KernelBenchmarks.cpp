@@ -0,0 +1,277 @@
+#include "KernelBenchmarks.hpp"
+
+#include "DenseVector.hpp"
+#include "DenseSymmetricMatrix.h"
+#include "SparseMatrix.h"
+#include "Variables.h"
+#include "DeSymIndefSolver.h"
+#include "DeSymPackedIndefSolver.h"
+#include "DistributedLinearSystem.h"
+#include "DistributedRootLinearSystem.h"
+#include "pipsdef.h"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+   /* grants access to the (protected) Schur complement assembly kernel */
+   class SCAssemblyKernels : public DistributedLinearSystem {
+   public:
+      using DistributedLinearSystem::addLeftBorderTimesDenseColsToResTranspDense;
+   };
+
+   std::mt19937 rank_generator(unsigned int seed, MPI_Comm comm = MPI_COMM_WORLD) {
+      return std::mt19937(seed + 7919u * static_cast<unsigned int>(PIPS_MPIgetRank(comm)));
+   }
+
+   /** m x n CSR matrix with min(nnz_per_row, n) randomly placed entries in [-1,1] per row */
+   std::unique_ptr<SparseMatrix> random_sparse_matrix(int m, int n, int nnz_per_row, std::mt19937& generator) {
+      nnz_per_row = std::min(nnz_per_row, n);
+      auto matrix = std::make_unique<SparseMatrix>(m, n, m * nnz_per_row);
+      SparseStorage& storage = matrix->getStorage();
+
+      std::uniform_int_distribution<int> col_distribution(0, n - 1);
+      std::uniform_real_distribution<double> val_distribution(-1.0, 1.0);
+
+      std::vector<int> cols;
+      cols.reserve(nnz_per_row);
+
+      storage.krowM[0] = 0;
+      for (int row = 0; row < m; ++row) {
+         cols.clear();
+         while (static_cast<int>(cols.size()) < nnz_per_row) {
+            const int col = col_distribution(generator);
+            if (std::find(cols.begin(), cols.end(), col) == cols.end())
+               cols.push_back(col);
+         }
+         std::sort(cols.begin(), cols.end());
+
+         const int row_start = storage.krowM[row];
+         for (int i = 0; i < nnz_per_row; ++i) {
+            storage.jcolM[row_start + i] = cols[i];
+            storage.M[row_start + i] = val_distribution(generator);
+         }
+         storage.krowM[row + 1] = row_start + nnz_per_row;
+      }
+
+      return matrix;
+   }
+
+   void fill_random(DenseVector<double>& vec, double low, double upp, std::mt19937& generator) {
+      std::uniform_real_distribution<double> distribution(low, upp);
+      for (int i = 0; i < vec.length(); ++i)
+         vec[i] = distribution(generator);
+   }
+
+   std::unique_ptr<Vector<double>> random_vector(int n, double low, double upp, std::mt19937& generator) {
+      auto vec = std::make_unique<DenseVector<double>>(n);
+      fill_random(*vec, low, upp, generator);
+      return vec;
+   }
+
+   /** dense iterate with lower and upper bounds on all variables and inequalities; gaps and duals positive for iterates, mixed sign for steps */
+   std::unique_ptr<Variables> random_variables(int nx, int my, int mz, bool is_step, std::mt19937& generator) {
+      const double low = is_step ? -1.0 : 0.1;
+      const double upp = 1.0;
+
+      auto ones_x = std::make_shared<DenseVector<double>>(nx);
+      ones_x->setToConstant(1.0);
+      auto ones_z = std::make_shared<DenseVector<double>>(mz);
+      ones_z->setToConstant(1.0);
+
+      return std::make_unique<Variables>(random_vector(nx, -1.0, 1.0, generator), random_vector(mz, -1.0, 1.0, generator),
+         random_vector(my, -1.0, 1.0, generator), random_vector(mz, -1.0, 1.0, generator), random_vector(nx, low, upp, generator),
+         random_vector(nx, low, upp, generator), random_vector(nx, low, upp, generator), random_vector(nx, low, upp, generator),
+         random_vector(mz, low, upp, generator), random_vector(mz, low, upp, generator), random_vector(mz, low, upp, generator),
+         random_vector(mz, low, upp, generator), ones_x, ones_x, ones_z, ones_z);
+   }
+
+   /** symmetric indefinite and well conditioned: random off-diagonal entries in [-1,1] and diagonal entries +-n */
+   void fill_random_indefinite(DenseSymmetricMatrix& matrix, std::mt19937& generator) {
+      double** const M = matrix.getStorage().M;
+      const int n = static_cast<int>(matrix.size());
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+      for (int i = 0; i < n; ++i) {
+         for (int j = 0; j < i; ++j) {
+            M[i][j] = distribution(generator);
+            M[j][i] = M[i][j];
+         }
+         M[i][i] = (i % 2 == 0) ? n : -n;
+      }
+   }
+}
+
+void benchmark_sparse_kernels(BenchmarkRunner& runner, int scale, unsigned int seed) {
+   if (!runner.any_enabled({"sparse_mult", "sparse_transmult"}))
+      return;
+
+   const int m = 100000 * scale;
+   const int n = 80000 * scale;
+   const int nnz_per_row = 10;
+
+   auto generator = rank_generator(seed);
+   const auto matrix = random_sparse_matrix(m, n, nnz_per_row, generator);
+   const SparseStorage& storage = matrix->getStorage();
+
+   DenseVector<double> x(n);
+   DenseVector<double> y(m);
+   fill_random(x, -1.0, 1.0, generator);
+   fill_random(y, -1.0, 1.0, generator);
+
+   const double flops = 2.0 * storage.len;
+   runner.run("sparse_mult", {{"rows", m}, {"cols", n}, {"nnz", storage.len}}, flops, "flop", [&]() {
+      storage.mult(1.0, y.elements(), 1e-3, x.elements());
+   });
+
+   runner.run("sparse_transmult", {{"rows", m}, {"cols", n}, {"nnz", storage.len}}, flops, "flop", [&]() {
+      storage.transMult(1.0, x.elements(), 1e-3, y.elements());
+   });
+}
+
+void benchmark_vector_kernels(BenchmarkRunner& runner, int scale, unsigned int seed) {
+   if (!runner.any_enabled({"vector_add_product", "vector_add_quotient", "vector_dot", "vector_fraction_to_boundary"}))
+      return;
+
+   const int n = 2000000 * scale;
+   const double vec_bytes = static_cast<double>(n) * sizeof(double);
+
+   auto generator = rank_generator(seed);
+   DenseVector<double> x(n);
+   DenseVector<double> y(n);
+   DenseVector<double> z(n);
+   fill_random(x, 0.1, 1.0, generator);
+   fill_random(y, -1.0, 1.0, generator);
+   fill_random(z, 0.1, 1.0, generator);
+
+   runner.run("vector_add_product", {{"n", n}}, 4 * vec_bytes, "byte", [&]() { x.add_product(1e-6, y, z); });
+   runner.run("vector_add_quotient", {{"n", n}}, 4 * vec_bytes, "byte", [&]() { x.add_quotient(1e-6, y, z); });
+
+   double dot = 0.0;
+   runner.run("vector_dot", {{"n", n}}, 2 * vec_bytes, "byte", [&]() { dot += x.dotProductWith(y); });
+
+   double alpha = 0.0;
+   runner.run("vector_fraction_to_boundary", {{"n", n}}, 2 * vec_bytes, "byte", [&]() {
+      alpha = std::max(alpha, x.fraction_to_boundary(y, 1.0));
+   });
+}
+
+void benchmark_variables_update(BenchmarkRunner& runner, int scale, unsigned int seed) {
+   if (!runner.any_enabled({"variables_add_pd", "variables_stepbound_pd"}))
+      return;
+
+   const int nx = 400000 * scale;
+   const int my = 200000 * scale;
+   const int mz = 200000 * scale;
+
+   auto generator = rank_generator(seed);
+   const auto iterate = random_variables(nx, my, mz, false, generator);
+   const auto step = random_variables(nx, my, mz, true, generator);
+
+   /* x, gamma, phi, v, w of size nx, y of size my and s, z, t, lambda, u, pi of size mz */
+   const double n_entries = 5.0 * nx + my + 6.0 * mz;
+   const double gap_entries = 4.0 * nx + 4.0 * mz;
+
+   runner.run("variables_add_pd", {{"nx", nx}, {"my", my}, {"mz", mz}}, 3 * n_entries * sizeof(double), "byte", [&]() {
+      iterate->add(*step, 1e-8, 1e-8);
+   });
+
+   double alpha = 0.0;
+   runner.run("variables_stepbound_pd", {{"nx", nx}, {"my", my}, {"mz", mz}}, 2 * gap_entries * sizeof(double), "byte", [&]() {
+      const auto[alpha_primal, alpha_dual] = iterate->stepbound_pd(*step);
+      alpha = std::max(alpha, std::min(alpha_primal, alpha_dual));
+   });
+}
+
+void benchmark_sc_assembly(BenchmarkRunner& runner, int scale, unsigned int seed) {
+   if (!runner.enabled("sc_assembly_dense"))
+      return;
+
+   /* leaf of size nx + my + mz with border R/A/C (n_link rows) and F/G (m_link rows each) */
+   const int nx = 10000 * scale;
+   const int my = 5000 * scale;
+   const int mz = 5000 * scale;
+   const int n_link = 200 * scale;
+   const int m_link = 50 * scale;
+   const int nnz_per_row = 50;
+
+   auto generator = rank_generator(seed);
+   const auto R = random_sparse_matrix(n_link, nx, nnz_per_row, generator);
+   const auto A = random_sparse_matrix(n_link, my, nnz_per_row, generator);
+   const auto C = random_sparse_matrix(n_link, mz, nnz_per_row, generator);
+   const auto F = random_sparse_matrix(m_link, nx, 2 * nnz_per_row, generator);
+   const auto G = random_sparse_matrix(m_link, nx, 2 * nnz_per_row, generator);
+   const BorderBiBlock border_left(*R, *A, *C, 0, *F, *G);
+
+   const int length_col = nx + my + mz;
+   const int n_cols = n_link + 2 * m_link;
+   const int n_cols_res = n_cols;
+
+   std::vector<double> cols(static_cast<size_t>(n_cols) * length_col);
+   std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+   std::generate(cols.begin(), cols.end(), [&]() { return distribution(generator); });
+
+   std::vector<int> cols_id(n_cols);
+   std::iota(cols_id.begin(), cols_id.end(), 0);
+
+   DenseSymmetricMatrix res(n_cols_res);
+   double** const res_rows = res.getStorage().M;
+
+   const double nnz_border = R->numberOfNonZeros() + A->numberOfNonZeros() + C->numberOfNonZeros() + F->numberOfNonZeros() + G->numberOfNonZeros();
+   runner.run("sc_assembly_dense", {{"length_col", length_col}, {"n_cols", n_cols}, {"nnz_border", nnz_border}}, 2.0 * nnz_border * n_cols, "flop",
+      [&]() {
+         SCAssemblyKernels::addLeftBorderTimesDenseColsToResTranspDense(border_left, cols.data(), cols_id.data(), length_col, n_cols, n_cols_res,
+            res_rows);
+      });
+}
+
+void benchmark_dense_factorization(BenchmarkRunner& runner, int scale, unsigned int seed) {
+   if (!runner.any_enabled({"dense_factorization_ldlt", "dense_factorization_ldlt_packed"}))
+      return;
+
+   const int n = 1500 * scale;
+   const double flops = static_cast<double>(n) * n * n / 3.0;
+
+   auto generator = rank_generator(seed);
+   DenseSymmetricMatrix matrix(n);
+   fill_random_indefinite(matrix, generator);
+
+   if (runner.enabled("dense_factorization_ldlt")) {
+      DeSymIndefSolver solver(matrix);
+      runner.run("dense_factorization_ldlt", {{"n", n}}, flops, "flop", [&]() { solver.matrixChanged(); });
+   }
+
+   if (runner.enabled("dense_factorization_ldlt_packed")) {
+      DeSymPackedIndefSolver solver(matrix);
+      runner.run("dense_factorization_ldlt_packed", {{"n", n}}, flops, "flop", [&]() { solver.matrixChanged(); });
+   }
+}
+
+void benchmark_sc_allreduce(BenchmarkRunner& runner, int scale, MPI_Comm comm) {
+   if (!runner.any_enabled({"sc_allreduce_full", "sc_allreduce_lower"}))
+      return;
+
+   const int n = 3000 * scale;
+
+   DenseSymmetricMatrix schur_complement(n);
+   double** const M = schur_complement.getStorage().M;
+
+   /* the values are reset before every repetition to keep them bounded */
+   const auto reset = [&]() {
+      for (int i = 0; i < n; ++i)
+         std::fill(M[i], M[i] + n, 1.0);
+   };
+
+   const double bytes_full = static_cast<double>(n) * n * sizeof(double);
+   runner.run("sc_allreduce_full", {{"n", n}, {"ranks", PIPS_MPIgetSize(comm)}}, bytes_full, "byte", [&]() {
+      DistributedRootLinearSystem::submatrixAllReduceFull(schur_complement, 0, 0, n, n, comm);
+   }, reset);
+
+   const double bytes_lower = 0.5 * (static_cast<double>(n) * n + n) * sizeof(double);
+   runner.run("sc_allreduce_lower", {{"n", n}, {"ranks", PIPS_MPIgetSize(comm)}}, bytes_lower, "byte", [&]() {
+      DistributedRootLinearSystem::submatrixAllReduceDiagLower(schur_complement, 0, n, comm);
+   }, reset);
+}
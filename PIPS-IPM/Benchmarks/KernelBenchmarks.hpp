@@ -0,0 +1,29 @@
+#ifndef PIPSIPMPP_KERNELBENCHMARKS_HPP
+#define PIPSIPMPP_KERNELBENCHMARKS_HPP
+
+#include "BenchmarkRunner.hpp"
+
+/*
+ * Microbenchmarks for the kernels dominating an IPM iteration. All problem sizes are multiplied by scale, all random data is generated
+ * from seed (and the rank) so that runs are reproducible.
+ */
+
+/** SparseStorage::mult and SparseStorage::transMult on a random CSR matrix */
+void benchmark_sparse_kernels(BenchmarkRunner& runner, int scale, unsigned int seed);
+
+/** fused DenseVector operations used in the step computation (add_product, add_quotient, dot products, fraction_to_boundary) */
+void benchmark_vector_kernels(BenchmarkRunner& runner, int scale, unsigned int seed);
+
+/** Variables step update and step length computation on dense iterates */
+void benchmark_variables_update(BenchmarkRunner& runner, int scale, unsigned int seed);
+
+/** Schur complement assembly res^T += border_left * cols as done after the leaf solves */
+void benchmark_sc_assembly(BenchmarkRunner& runner, int scale, unsigned int seed);
+
+/** factorization of a dense symmetric indefinite Schur complement by the available dense root solvers */
+void benchmark_dense_factorization(BenchmarkRunner& runner, int scale, unsigned int seed);
+
+/** allreduce of a dense Schur complement, once as full matrix and once as chunked lower triangle */
+void benchmark_sc_allreduce(BenchmarkRunner& runner, int scale, MPI_Comm comm);
+
+#endif //PIPSIPMPP_KERNELBENCHMARKS_HPP
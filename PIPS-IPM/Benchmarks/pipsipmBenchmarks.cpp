@@ -0,0 +1,154 @@
+/*
+ * Kernel and scaling benchmarks for PIPS-IPM++.
+ *
+ * Every kernel is run on all ranks of MPI_COMM_WORLD; a repetition is timed from a barrier until the slowest rank finishes. Results are
+ * written as JSON (to --output) so that runs of different releases can be compared, a short summary goes to stdout.
+ */
+#include "BenchmarkRunner.hpp"
+#include "KernelBenchmarks.hpp"
+
+#include "PIPSIPMppInterface.hpp"
+#include "PIPSIPMppOptions.h"
+#include "problem_generator.hpp"
+#include "pipsdef.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+   struct BenchmarkSettings {
+      int scale{1};
+      int repetitions{5};
+      int warmup{1};
+      unsigned int seed{42};
+      std::string filter;
+      std::string output{"pipsipmpp_benchmarks.json"};
+   };
+
+   void print_usage(const char* name) {
+      std::cout << "Usage: " << name << " [--scale N] [--reps N] [--warmup N] [--seed N] [--filter SUBSTRING] [--output FILE]\n";
+      std::cout << "  --scale   multiplies all problem sizes (default 1)\n";
+      std::cout << "  --reps    timed repetitions per benchmark (default 5)\n";
+      std::cout << "  --warmup  untimed repetitions per benchmark (default 1)\n";
+      std::cout << "  --seed    seed for all generated data (default 42)\n";
+      std::cout << "  --filter  only run benchmarks whose name contains SUBSTRING\n";
+      std::cout << "  --output  JSON result file (default pipsipmpp_benchmarks.json)\n";
+   }
+
+   bool parse_arguments(int argc, char** argv, BenchmarkSettings& settings) {
+      for (int i = 1; i < argc; ++i) {
+         const std::string arg(argv[i]);
+         if (i + 1 >= argc)
+            return false;
+
+         const std::string value(argv[++i]);
+         try {
+            if (arg == "--scale")
+               settings.scale = std::stoi(value);
+            else if (arg == "--reps")
+               settings.repetitions = std::stoi(value);
+            else if (arg == "--warmup")
+               settings.warmup = std::stoi(value);
+            else if (arg == "--seed")
+               settings.seed = static_cast<unsigned int>(std::stoul(value));
+            else if (arg == "--filter")
+               settings.filter = value;
+            else if (arg == "--output")
+               settings.output = value;
+            else
+               return false;
+         }
+         catch (const std::exception&) {
+            return false;
+         }
+      }
+      return settings.scale > 0 && settings.repetitions > 0 && settings.warmup >= 0;
+   }
+
+   /* without a sparse solver the options cannot be initialized - so this must not touch them */
+   bool sparse_solver_available() {
+      for (const SolverType solver : {SolverType::SOLVER_MA27, SolverType::SOLVER_MA57, SolverType::SOLVER_PARDISO, SolverType::SOLVER_MKL_PARDISO,
+         SolverType::SOLVER_MUMPS}) {
+         if (pipsipmpp_options::is_solver_available(solver))
+            return true;
+      }
+      return false;
+   }
+
+   void benchmark_ipm(BenchmarkRunner& runner, int scale, unsigned int seed) {
+      const std::string name = "ipm_generated";
+      if (!runner.enabled(name))
+         return;
+
+      if (!sparse_solver_available()) {
+         runner.skip(name, "no sparse linear solver available");
+         return;
+      }
+
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+
+      generator_parameters parameters;
+      parameters.n_scenarios = 4 * PIPS_MPIgetSize();
+      parameters.n_first_stage_vars = 100 * scale;
+      parameters.n_first_stage_eq = 20 * scale;
+      parameters.n_first_stage_ineq = 20 * scale;
+      parameters.n_block_vars = 2000 * scale;
+      parameters.n_block_eq = 800 * scale;
+      parameters.n_block_ineq = 400 * scale;
+      parameters.density = 0.005;
+      parameters.n_linking_eq = 10;
+      parameters.seed = seed;
+      problem_generator generator(parameters);
+
+      int iterations = 0;
+      runner.run(name, {{"scenarios", parameters.n_scenarios}, {"first_stage_vars", parameters.n_first_stage_vars},
+         {"block_vars", parameters.n_block_vars}, {"linking_eq", parameters.n_linking_eq}}, 0.0, "", [&]() {
+         auto tree = generator.generate_problem();
+         PIPSIPMppInterface pipsIpm(tree.get(), InteriorPointMethodType::PRIMAL, MPI_COMM_WORLD, ScalerType::GEOMETRIC_MEAN, PresolverType::NONE);
+         pipsIpm.run();
+         iterations = pipsIpm.n_iterations();
+      });
+      runner.add_parameter_to_last("iterations", iterations);
+   }
+}
+
+int main(int argc, char** argv) {
+   MPI_Init(&argc, &argv);
+   const int rank = PIPS_MPIgetRank();
+
+   BenchmarkSettings settings;
+   if (!parse_arguments(argc, argv, settings)) {
+      if (rank == 0)
+         print_usage(argv[0]);
+      MPI_Finalize();
+      return 1;
+   }
+
+   {
+      BenchmarkRunner runner(MPI_COMM_WORLD, settings.repetitions, settings.warmup, settings.filter);
+
+      benchmark_sparse_kernels(runner, settings.scale, settings.seed);
+      benchmark_vector_kernels(runner, settings.scale, settings.seed);
+      benchmark_variables_update(runner, settings.scale, settings.seed);
+      benchmark_sc_assembly(runner, settings.scale, settings.seed);
+      benchmark_dense_factorization(runner, settings.scale, settings.seed);
+      benchmark_sc_allreduce(runner, settings.scale, MPI_COMM_WORLD);
+      benchmark_ipm(runner, settings.scale, settings.seed);
+
+      if (rank == 0) {
+         runner.print_summary(std::cout);
+
+         std::ofstream out(settings.output);
+         if (out)
+            runner.write_json(out);
+         else
+            std::cout << "Error: could not open benchmark output file " << settings.output << "\n";
+      }
+   }
+
+   MPI_Finalize();
+   return 0;
+}
@@ -12,7 +12,8 @@ FilterLineSearch::FilterLineSearch(DistributedFactory& factory, Problem& problem
       const Scaler* scaler) :
       filter_strategy(FilterStrategy()),
       interior_point_method(MehrotraFactory::create(factory, problem, dnorm, interior_point_method_type, scaler)),
-      verbose{PIPS_MPIgetRank() == 0 && pipsipmpp_options::get_bool_parameter("FILTER_VERBOSE")} {
+      verbose{PIPS_MPIgetRank() == 0 && pipsipmpp_options::get_bool_parameter("FILTER_VERBOSE")},
+      backtracking{pipsipmpp_options::get_bool_parameter("FILTER_LINE_SEARCH")} {
 }
 
 void FilterLineSearch::initialize(Residuals& initial_residuals) {
@@ -24,9 +25,25 @@ void FilterLineSearch::register_observer(AbstractLinearSystem* linear_system) {
    this->interior_point_method->register_observer(linear_system);
 }
 
+void FilterLineSearch::unregister_observer() {
+   this->interior_point_method->removeSubject();
+}
+
 void FilterLineSearch::compute_acceptable_iterate(Problem& problem, Variables& current_iterate, Residuals& current_residuals, Variables& step,
       AbstractLinearSystem& linear_system, int iteration) {
    double mu = current_iterate.mu();
+   if (this->backtracking) {
+      if (!current_residuals_copy) {
+         current_residuals_copy = current_residuals.clone_full();
+         primal_residual_change = current_residuals.clone_full();
+         dual_residual_change = current_residuals.clone_full();
+         trial_residuals = current_residuals.clone_full();
+         trial_iterate = current_iterate.clone_full();
+         this->initialize(current_residuals);
+      }
+      // the step computation may overwrite the residuals (probing) - keep the ones of the current iterate
+      current_residuals_copy->copy(current_residuals);
+   }
    // compute the predictor direction
    if (print_level >= 10) {
       this->print_statistics(problem, current_iterate, current_residuals, iteration, mu, TerminationStatus::NOT_FINISHED, 0);
@@ -37,42 +54,56 @@ void FilterLineSearch::compute_acceptable_iterate(Problem& problem, Variables& c
       this->print_statistics(problem, current_iterate, current_residuals, iteration, mu, TerminationStatus::NOT_FINISHED, 2);
    }
    this->interior_point_method->compute_corrector_step(problem, current_iterate, current_residuals, step, linear_system, iteration, small_corr);
-   this->interior_point_method->take_step(current_iterate, step, 1.);
 
-//   bool is_accepted = false;
-//   this->number_iterations = 0;
-//   double step_length = 1.;
-//   while (!this->termination(is_accepted)) {
-//      this->number_iterations++;
-//      if (verbose) std::cout << "Line search current step length: " << step_length << "\n";
-//      // compute the trial iterate
-//      std::unique_ptr<Variables> trial_iterate = current_iterate.clone_full();
-//      auto [primal_length, dual_length] = this->interior_point_method->get_step_lengths();
-//      this->interior_point_method->take_step(*trial_iterate, step, step_length*primal_length);
-//
-//      // evaluate the residuals at the trial iterate
-//      std::unique_ptr<Residuals> trial_residuals = current_residuals.clone_full();
-//      trial_residuals->evaluate(problem, *trial_iterate);
-//      trial_residuals->compute_residual_norm();
-//
-//      const double predicted_reduction = PIPSIPMppSolver::predicted_reduction(problem, current_iterate, step, trial_iterate->mu(), step_length);
-//      if (verbose) std::cout << "Predicted reduction: " << predicted_reduction << "\n";
-//
-//      /* check whether the trial step is accepted */
-//      is_accepted = this->filter_strategy.check_acceptance(current_residuals, *trial_residuals, predicted_reduction);
-//      if (is_accepted) {
-//         // if the trial iterate was accepted, overwrite current_iterate
-//         current_iterate.copy(*trial_iterate);
-//      }
-//      else {
-//         // decrease the step length
-//         step_length *= this->backtracking_ratio;
-//         if (verbose) std::cout << "LS trial iterate rejected\n";
-//      }
-//   }
-//   if (!is_accepted) {
-//      assert(false && "Enter restoration phase (not implemented yet)");
-//   }
+   if (this->backtracking)
+      this->backtrack(problem, current_iterate, step);
+   else
+      this->interior_point_method->take_step(current_iterate, step, 1.);
+}
+
+/* the linear residuals are affine along the step: r(x + alpha * dx) = r(x) + alpha * dr, with dr holding all matrix-vector products,
+ * the complementarity is bilinear in the primal and dual step length. All of that and the directional derivative of the barrier
+ * function are computed once per direction, every trial is then vector updates plus one reduction for the residual norm */
+void FilterLineSearch::backtrack(Problem& problem, Variables& current_iterate, Variables& step) {
+   auto [primal_length, dual_length] = this->interior_point_method->get_step_lengths();
+   primal_residual_change->evaluate_step_change(problem, current_iterate, step, *dual_residual_change);
+   const auto directional_derivative_terms = PIPSIPMppSolver::barrier_directional_derivative_terms(problem, current_iterate, step);
+
+   bool is_accepted = false;
+   this->number_iterations = 0;
+   double step_length = 1.;
+   while (!this->termination(is_accepted)) {
+      this->number_iterations++;
+      if (verbose) std::cout << "Line search current step length: " << step_length << "\n";
+      // compute the trial iterate
+      trial_iterate->copy(current_iterate);
+      this->interior_point_method->take_step(*trial_iterate, step, step_length);
+
+      // update the residuals along the step instead of evaluating them at the trial iterate
+      trial_residuals->evaluate_along_step(*current_residuals_copy, *primal_residual_change, *dual_residual_change,
+         step_length * primal_length, step_length * dual_length);
+
+      const double predicted_reduction =
+         PIPSIPMppSolver::predicted_reduction(directional_derivative_terms, trial_residuals->get_mu(), step_length);
+      if (verbose) std::cout << "Predicted reduction: " << predicted_reduction << "\n";
+
+      /* check whether the trial step is accepted */
+      is_accepted = this->filter_strategy.check_acceptance(*current_residuals_copy, *trial_residuals, predicted_reduction);
+      if (is_accepted) {
+         // if the trial iterate was accepted, overwrite current_iterate
+         current_iterate.copy(*trial_iterate);
+      }
+      else {
+         // decrease the step length
+         step_length *= this->backtracking_ratio;
+         if (verbose) std::cout << "LS trial iterate rejected\n";
+      }
+   }
+   if (!is_accepted) {
+      /* no restoration phase yet - keep the last and shortest trial */
+      if (verbose) std::cout << "Line search failed, taking shortest trial step\n";
+      current_iterate.copy(*trial_iterate);
+   }
 }
 
 bool FilterLineSearch::termination(bool is_accepted) const {
@@ -30,6 +30,7 @@ public:
    int number_iterations{0};
    void initialize(Residuals& initial_residuals);
    void register_observer(AbstractLinearSystem* linear_system);
+   void unregister_observer();
    void compute_acceptable_iterate(Problem& problem, Variables& current_iterate, Residuals& current_residuals, Variables& step, AbstractLinearSystem& linear_system,
          int iteration);
    void print_statistics(const Problem& problem, const Variables& iterate, const Residuals& residuals, int i, double mu,
@@ -40,8 +41,17 @@ private:
    double min_step_length{1e-9};
    const int max_iterations{20};
    const bool verbose{false};
+   const bool backtracking{false};
+
+   /* residuals at the current iterate and their change along the step - trial residuals are affine updates of these */
+   std::unique_ptr<Residuals> current_residuals_copy;
+   std::unique_ptr<Residuals> primal_residual_change;
+   std::unique_ptr<Residuals> dual_residual_change;
+   std::unique_ptr<Residuals> trial_residuals;
+   std::unique_ptr<Variables> trial_iterate;
 
    [[nodiscard]] bool termination(bool is_accepted) const;
+   void backtrack(Problem& problem, Variables& current_iterate, Variables& step);
 };
 
 #endif // FILTERLINESEARCH_H
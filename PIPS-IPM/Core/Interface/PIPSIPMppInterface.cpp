@@ -3,28 +3,38 @@
 //
 
 #include "PIPSIPMppInterface.hpp"
+#include "AbstractLinearSystem.h"
 #include "DistributedFactory.hpp"
 #include "DistributedProblem.hpp"
 #include "DistributedResiduals.hpp"
 #include "DistributedTreeCallbacks.h"
 #include "DistributedVariables.h"
+#include "HierarchicalAutotuner.hpp"
+#include "NodeTopology.h"
 #include "PIPSIPMppOptions.h"
 #include "PIPSIPMppSolver.hpp"
 #include "PreprocessFactory.h"
 #include "PreprocessType.h"
 #include "Scaler.hpp"
+#include "StochResourcesMonitor.hpp"
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
 
 PIPSIPMppInterface::PIPSIPMppInterface(DistributedInputTree *tree, InteriorPointMethodType mehrotra_heuristic,
                                        MPI_Comm comm, ScalerType scaler_type, PresolverType presolver_type,
                                        const std::string &settings)
-    : comm(comm), my_rank(PIPS_MPIgetRank(comm)) {
+    : comm(comm), my_rank(PIPS_MPIgetRank(comm)), interior_point_method_type(mehrotra_heuristic), scaler_type(scaler_type) {
+    const size_t rss_before_problem = MemoryMonitor::residentSetSize();
     factory = std::make_unique<DistributedFactory>(tree, comm);
     pipsipmpp_options::set_options(settings);
     const bool postsolve = pipsipmpp_options::get_bool_parameter("POSTSOLVE");
 
+    NodeTopology::setSimulatedRanksPerNode(pipsipmpp_options::get_int_parameter("MPI_SIMULATED_RANKS_PER_NODE"));
+    NodeTopology::setTwoStageReductions(pipsipmpp_options::get_bool_parameter("HIERARCHICAL") &&
+                                        pipsipmpp_options::get_bool_parameter("HIERARCHICAL_NODE_AWARE_REDUCTIONS"));
+
     MPI_Barrier(comm);
     const double t0 = MPI_Wtime();
 
@@ -87,6 +97,10 @@ PIPSIPMppInterface::PIPSIPMppInterface(DistributedInputTree *tree, InteriorPoint
         if (my_rank == 0)
             std::cout << "Using hierarchical approach!\n";
 
+        auto &distributed_problem = dynamic_cast<DistributedProblem &>(*presolved_problem);
+        if (pipsipmpp_options::get_bool_parameter("HIERARCHICAL_AUTOTUNE") && distributed_problem.exploitingLinkStructure())
+            HierarchicalAutotuner(distributed_problem, comm).tune();
+
         presolved_problem.reset(dynamic_cast<DistributedProblem *>(
             factory->switchToHierarchicalData(dynamic_cast<DistributedProblem *>(presolved_problem.release()))));
 
@@ -94,6 +108,14 @@ PIPSIPMppInterface::PIPSIPMppInterface(DistributedInputTree *tree, InteriorPoint
             presolved_problem->write_to_streamDense(std::cout);
     }
 
+    const size_t postsolve_bytes = postsolver ? postsolver->memory_footprint() : 0;
+    MemoryMonitor::allocate(MemoryCategory::POSTSOLVE, postsolve_bytes);
+
+    // the problem data is not accounted for explicitly - attribute the resident set growth while reading and presolving it
+    const size_t rss_after_problem = MemoryMonitor::residentSetSize();
+    if (rss_after_problem > rss_before_problem + postsolve_bytes)
+        MemoryMonitor::allocate(MemoryCategory::PROBLEM_DATA, rss_after_problem - rss_before_problem - postsolve_bytes);
+
     variables = factory->make_variables(*presolved_problem);
 #ifdef TIMING
     if (my_rank == 0)
@@ -188,6 +210,9 @@ TerminationStatus PIPSIPMppInterface::run() {
 
     ran_solver = true;
 
+    if (pipsipmpp_options::get_bool_parameter("PRINT_MEMORY_REPORT"))
+        factory->tree->resMon.printMemoryReport(comm);
+
 #if !defined(NDEBUG) && defined(PRESOLVE_POSTSOLVE_ONLY)
     postsolveComputedSolution();
 #endif
@@ -197,6 +222,70 @@ TerminationStatus PIPSIPMppInterface::run() {
 
 TerminationStatus PIPSIPMppInterface::termination_status() const { return result; }
 
+void PIPSIPMppInterface::update_problem_data() {
+    /* presolve and the hierarchical data change the problem read from the tree beyond a reproducible permutation */
+    if (presolver || pipsipmpp_options::get_bool_parameter("HIERARCHICAL"))
+        throw std::logic_error("PIPSIPMppInterface: updating the problem data is not supported with presolve or HIERARCHICAL");
+
+    MPI_Barrier(comm);
+    const double t0 = MPI_Wtime();
+
+    // the scaling happened in place - matrices lent through FMATBORROW must hold the user's values again before they are re-read
+    if (scaler)
+        scaler->unscale_matrices();
+
+    const std::unique_ptr<Problem> updated_problem = factory->make_problem();
+
+    // reject the update before anything gets changed - the interface stays usable with the old data
+    bool same_structure = dataUnpermNotHier->has_same_structure(*updated_problem);
+    PIPS_MPIgetLogicAndInPlace(same_structure, comm);
+    if (!same_structure) {
+        if (scaler)
+            scaler->rescale_matrices();
+        throw std::invalid_argument("PIPSIPMppInterface: the updated problem changes bound indicators or matrix sparsity patterns");
+    }
+
+    bool copied = dataUnpermNotHier->copy_values_from(*updated_problem);
+
+    // the link structure permutation only depends on the sparsity patterns - the updated problem gets the one of the solved problem
+    if (dynamic_cast<const DistributedProblem &>(*presolved_problem).exploitingLinkStructure())
+        dynamic_cast<DistributedProblem &>(*updated_problem).activateLinkStructureExploitation();
+    assert(presolved_problem->has_same_structure(*updated_problem));
+
+    std::unique_ptr<AbstractLinearSystem> linear_system = solver->release_linear_system();
+    solver.reset();
+
+    // the last iterate is kept as starting point - it leaves the coordinates of the old scaling and enters those of the new one
+    if (scaler)
+        scaler->unscale_variables(*variables);
+
+    // overwrites the (possibly scaled) values - the old scaling is void afterwards
+    copied = copied && presolved_problem->copy_values_from(*updated_problem);
+    assert(copied);
+    (void) copied;
+
+    if (scaler) {
+        scaler = preprocess_factory->make_scaler(*factory, *presolved_problem, scaler_type);
+        scaler->scale();
+        scaler->scale_variables(*variables);
+    }
+
+    if (linear_system)
+        linear_system->problem_data_changed();
+
+    solver = std::make_unique<PIPSIPMppSolver>(*factory, *presolved_problem, interior_point_method_type, scaler.get(),
+                                               std::move(linear_system));
+
+    unscaleUnpermNotHierVars.reset();
+    unscaleUnpermNotHierResids.reset();
+    result = TerminationStatus::DID_NOT_RUN;
+    ran_solver = false;
+
+    MPI_Barrier(comm);
+    if (my_rank == 0)
+        std::cout << "---update time (in sec.): " << MPI_Wtime() - t0 << "\n";
+}
+
 int PIPSIPMppInterface::n_iterations() const {
     if (!ran_solver)
         throw std::logic_error(
@@ -269,23 +358,41 @@ void PIPSIPMppInterface::getResidsUnscaledUnperm() {
         unscaleUnpermNotHierResids.reset(qp_presolved_problem.getResidsUnperm(*residuals, *dataUnpermNotHier));
 }
 
-std::vector<double>
-PIPSIPMppInterface::gatherFromSolution(std::unique_ptr<Vector<double>> Variables::*member_to_gather) {
+const Vector<double> &PIPSIPMppInterface::getFromSolution(std::unique_ptr<Vector<double>> Variables::*member) {
     if (!unscaleUnpermNotHierVars)
         this->getVarsUnscaledUnperm();
 
     if (postsolver && !postsolved_variables)
         this->postsolveComputedSolution();
 
-    std::vector<double> vec;
     if (!postsolver)
-        vec = dynamic_cast<const DistributedVector<double> &>(*(*unscaleUnpermNotHierVars.*member_to_gather))
-                  .gatherStochVector();
+        return *(*unscaleUnpermNotHierVars.*member);
     else
-        vec = dynamic_cast<const DistributedVector<double> &>(*(*postsolved_variables.*member_to_gather))
-                  .gatherStochVector();
+        return *(*postsolved_variables.*member);
+}
 
-    return vec;
+std::vector<double>
+PIPSIPMppInterface::gatherFromSolution(std::unique_ptr<Vector<double>> Variables::*member_to_gather) {
+    return dynamic_cast<const DistributedVector<double> &>(getFromSolution(member_to_gather)).gatherStochVector();
+}
+
+void PIPSIPMppInterface::writeSolutionBlocks(const std::string &file_name_prefix) {
+    const std::pair<const char *, std::unique_ptr<Vector<double>> Variables::*> parts[] = {
+        {"_primal.bin", &DistributedVariables::primals},
+        {"_dual_eq.bin", &DistributedVariables::equality_duals},
+        {"_dual_ineq.bin", &DistributedVariables::inequality_duals},
+        {"_dual_varbounds_upp.bin", &DistributedVariables::primal_upper_bound_gap_dual},
+        {"_dual_varbounds_low.bin", &DistributedVariables::primal_lower_bound_gap_dual}};
+
+    for (const auto &[suffix, member] : parts)
+        dynamic_cast<const DistributedVector<double> &>(getFromSolution(member))
+            .writeBlocksToFile(file_name_prefix + suffix);
+}
+
+void PIPSIPMppInterface::forEachLocalPrimalSolutionBlock(
+    const std::function<void(int block, const double *values, int length)> &visit) {
+    dynamic_cast<const DistributedVector<double> &>(getFromSolution(&DistributedVariables::primals))
+        .forEachLocalBlock(visit);
 }
 
 std::vector<double>
@@ -5,6 +5,7 @@
 #ifndef PIPSIPMPPINTERFACE_H
 #define PIPSIPMPPINTERFACE_H
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -40,6 +41,13 @@ class PIPSIPMppInterface {
     TerminationStatus run();
     TerminationStatus termination_status() const;
 
+    /** re-reads the problem values through the callbacks of the input tree so that run() can be called again - bounds,
+     * right-hand sides, objective and matrix values may change but the bound indicators and the sparsity patterns have to
+     * stay the same; the tree, the communicators and the linear systems with their symbolic factorizations are reused and
+     * the last solution serves as starting point. Matrices lent through FMATBORROW are unscaled before they are read again,
+     * so their borrow callbacks see (and may overwrite) the user's values. Not available with presolve or HIERARCHICAL */
+    void update_problem_data();
+
     double getObjective();
 
     [[nodiscard]] int n_iterations() const;
@@ -78,6 +86,15 @@ class PIPSIPMppInterface {
 
     std::vector<double> gatherDualResids();
 
+    /** parallel alternative to the gather* calls - every process writes its own scenario blocks of the primal solution and
+     * of the duals into <file_name_prefix>_{primal,dual_eq,dual_ineq,dual_varbounds_upp,dual_varbounds_low}.bin; see
+     * DistributedVector::writeBlocksToFile for the layout */
+    void writeSolutionBlocks(const std::string &file_name_prefix);
+
+    /** streams the primal solution blocks held by this process without any gathering - block 0 is the first stage, block
+     * 1 + i scenario i and the last block the linking part; see DistributedVector::forEachLocalBlock */
+    void forEachLocalPrimalSolutionBlock(const std::function<void(int block, const double *values, int length)> &visit);
+
     [[nodiscard]] std::vector<double> getFirstStagePrimalColSolution() const;
 
     [[nodiscard]] std::vector<double> getSecondStagePrimalColSolution(int scen) const;
@@ -99,6 +116,7 @@ class PIPSIPMppInterface {
   private:
     static void printComplementarityResiduals(const Variables &vars);
 
+    const Vector<double> &getFromSolution(std::unique_ptr<Vector<double>> Variables::*member);
     std::vector<double> gatherFromSolution(std::unique_ptr<Vector<double>> Variables::*member_to_gather);
     std::vector<double> gatherFromResiduals(std::unique_ptr<Vector<double>> Residuals::*member_to_gather);
 
@@ -124,6 +142,8 @@ class PIPSIPMppInterface {
 
     MPI_Comm comm = MPI_COMM_NULL;
     const int my_rank = -1;
+    const InteriorPointMethodType interior_point_method_type;
+    const ScalerType scaler_type;
     TerminationStatus result{TerminationStatus::DID_NOT_RUN};
     bool ran_solver = false;
 };
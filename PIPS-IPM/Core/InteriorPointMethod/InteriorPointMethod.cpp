@@ -186,7 +186,7 @@ void PrimalInteriorPointMethod::take_step(Variables &iterate, const Variables &s
 }
 
 void PrimalDualInteriorPointMethod::take_step(Variables &iterate, const Variables &step, double step_length) {
-    iterate.add(step, this->primal_step_length, this->dual_step_length * step_length);
+    iterate.add(step, this->primal_step_length * step_length, this->dual_step_length * step_length);
 }
 
 void PrimalDualInteriorPointMethod::compute_corrector_step(const Problem &problem, Variables &current_iterate,
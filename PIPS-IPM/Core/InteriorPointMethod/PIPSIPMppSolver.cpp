@@ -11,9 +11,15 @@ extern int print_level;
 
 PIPSIPMppSolver::PIPSIPMppSolver(DistributedFactory &factory, Problem &problem,
                                  InteriorPointMethodType interior_point_method_type, const Scaler *scaler)
+    : PIPSIPMppSolver(factory, problem, interior_point_method_type, scaler, nullptr) {}
+
+PIPSIPMppSolver::PIPSIPMppSolver(DistributedFactory &factory, Problem &problem,
+                                 InteriorPointMethodType interior_point_method_type, const Scaler *scaler,
+                                 std::unique_ptr<AbstractLinearSystem> linear_system)
     : Solver(factory, problem), scaler(scaler), max_iterations(300), dnorm(problem.datanorm()),
       dnorm_orig(scaler ? scaler->getDnormOrig() : dnorm),
       filter_line_search(factory, problem, dnorm, interior_point_method_type, scaler),
+      linear_system(std::move(linear_system)),
       // allocate space to track the sequence problem_formulation
       // complementarity gaps, residual norms, and merit functions.
       mu_history(max_iterations), residual_norm_history(max_iterations), phi_history(max_iterations),
@@ -29,9 +35,12 @@ PIPSIPMppSolver::PIPSIPMppSolver(DistributedFactory &factory, Problem &problem,
     }
 }
 
+PIPSIPMppSolver::~PIPSIPMppSolver() = default;
+
 TerminationStatus PIPSIPMppSolver::solve(Problem &problem, Variables &iterate, Residuals &residuals) {
-    // initialization of (x,y,z) and factorization routine.
-    std::unique_ptr<AbstractLinearSystem> linear_system = factory.make_linear_system(problem);
+    // initialization of (x,y,z) and factorization routine - kept for later solves
+    if (!linear_system)
+        linear_system = factory.make_linear_system(problem);
     // register the linear system to the step computation strategy
     this->filter_line_search.register_observer(linear_system.get());
 
@@ -85,35 +94,40 @@ TerminationStatus PIPSIPMppSolver::solve(Problem &problem, Variables &iterate, R
     return status;
 }
 
-double PIPSIPMppSolver::barrier_directional_derivative(Problem &problem, Variables &iterate, Variables &direction,
-                                                       double mu) {
-    double result = 0.;
+std::unique_ptr<AbstractLinearSystem> PIPSIPMppSolver::release_linear_system() {
+    if (linear_system)
+        this->filter_line_search.unregister_observer();
+    return std::move(linear_system);
+}
+
+std::pair<double, double> PIPSIPMppSolver::barrier_directional_derivative_terms(Problem &problem, Variables &iterate,
+                                                                               Variables &direction) {
+    double barrier_term = 0.;
     if (0 < problem.number_primal_lower_bounds) { // v
-        result -= direction.primal_lower_bound_gap->barrier_directional_derivative(
+        barrier_term -= direction.primal_lower_bound_gap->barrier_directional_derivative(
             *iterate.primal_lower_bound_gap, 0., *problem.primal_lower_bound_indicators);
     }
     if (0 < problem.number_primal_upper_bounds) { // w
-        result -= direction.primal_upper_bound_gap->barrier_directional_derivative(
+        barrier_term -= direction.primal_upper_bound_gap->barrier_directional_derivative(
             *iterate.primal_upper_bound_gap, 0., *problem.primal_upper_bound_indicators);
     }
     if (0 < problem.number_inequality_lower_bounds) { // t
-        result -= direction.slack_lower_bound_gap->barrier_directional_derivative(
+        barrier_term -= direction.slack_lower_bound_gap->barrier_directional_derivative(
             *iterate.slack_lower_bound_gap, 0., *problem.inequality_lower_bound_indicators);
     }
     if (0 < problem.number_inequality_upper_bounds) { // u
-        result -= direction.slack_upper_bound_gap->barrier_directional_derivative(
+        barrier_term -= direction.slack_upper_bound_gap->barrier_directional_derivative(
             *iterate.slack_upper_bound_gap, 0., *problem.inequality_upper_bound_indicators);
     }
-    result *= mu;
-    result += problem.objective_gradient->dotProductWith(*direction.primals);
-    return result;
+    return std::make_pair(barrier_term, problem.objective_gradient->dotProductWith(*direction.primals));
 }
 
-double PIPSIPMppSolver::predicted_reduction(Problem &problem, Variables &iterate, Variables &direction, double mu,
+double PIPSIPMppSolver::predicted_reduction(const std::pair<double, double> &directional_derivative_terms, double mu,
                                             double step_length) {
-    // scale it with the step length and return the predicted reduction (should be
+    const auto [barrier_term, objective_term] = directional_derivative_terms;
+    // scale the barrier directional derivative with the step length and return the predicted reduction (should be
     // positive for a descent direction)
-    return -step_length * PIPSIPMppSolver::barrier_directional_derivative(problem, iterate, direction, mu);
+    return -step_length * (mu * barrier_term + objective_term);
 }
 
 std::pair<double, double> PIPSIPMppSolver::compute_unscaled_gap_and_residual_norm(const Problem &problem,
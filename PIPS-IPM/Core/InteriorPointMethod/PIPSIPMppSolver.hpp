@@ -5,6 +5,8 @@
 #include "InteriorPointMethodType.hpp"
 #include "Solver.hpp"
 
+class AbstractLinearSystem;
+
 class Problem;
 
 class Variables;
@@ -17,11 +19,23 @@ class PIPSIPMppSolver : public Solver {
   public:
     PIPSIPMppSolver(DistributedFactory &factory, Problem &problem, InteriorPointMethodType interior_point_method_type,
                     const Scaler *scaler = nullptr);
-    ~PIPSIPMppSolver() override = default;
+    /** linear_system may be one released by a solver for a problem with the same structure - it is created on the first
+     * call to solve otherwise */
+    PIPSIPMppSolver(DistributedFactory &factory, Problem &problem, InteriorPointMethodType interior_point_method_type,
+                    const Scaler *scaler, std::unique_ptr<AbstractLinearSystem> linear_system);
+    ~PIPSIPMppSolver() override;
 
     TerminationStatus solve(Problem &problem, Variables &iterate, Residuals &residuals) override;
 
-    static double predicted_reduction(Problem &problem, Variables &iterate, Variables &direction, double mu,
+    /** hands over the linear system (kept alive between calls to solve) together with its symbolic factorizations */
+    std::unique_ptr<AbstractLinearSystem> release_linear_system();
+
+    /** the barrier part (to be scaled by mu) and the objective part g'dx of the barrier directional derivative along direction -
+     * both do not depend on the step length, so they are computed once per direction */
+    static std::pair<double, double> barrier_directional_derivative_terms(Problem &problem, Variables &iterate,
+                                                                          Variables &direction);
+
+    static double predicted_reduction(const std::pair<double, double> &directional_derivative_terms, double mu,
                                       double step_length);
 
     [[nodiscard]] int n_iterations() const { return iteration; };
@@ -37,6 +51,7 @@ class PIPSIPMppSolver : public Solver {
     const double dnorm_orig{0.};
 
     FilterLineSearch filter_line_search;
+    std::unique_ptr<AbstractLinearSystem> linear_system;
     std::unique_ptr<Residuals> residuals_unscaled;
 
     /** history of values of mu obtained on all iterations to date */
@@ -63,7 +78,6 @@ class PIPSIPMppSolver : public Solver {
                                                                      const Residuals &residuals);
     void update_history(double duality_gap, double residual_norm, int iteration, double mu);
     TerminationStatus compute_status(double duality_gap, double residual_norm, int iteration, double mu);
-    static double barrier_directional_derivative(Problem &problem, Variables &iterate, Variables &direction, double mu);
 };
 
 #endif /* PIPSIPMPPSOLVER_H */
@@ -24,6 +24,10 @@ public:
    /** assuming the "factor" call was successful, supplies the right-hand side and solves the system. */
    virtual void solve(const Variables& iterate, const Residuals& residuals, Variables& step) = 0;
 
+   /** the values (but not the structure) of the problem this system was created for changed - refreshes everything copied
+    * from it so that the system, including its symbolic factorizations, can be reused for the new data */
+   virtual void problem_data_changed() {}
+
    virtual ~AbstractLinearSystem() = default;
 };
 
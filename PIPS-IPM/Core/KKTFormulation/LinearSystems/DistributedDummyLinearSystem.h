@@ -16,6 +16,7 @@ public:
    void factor2() override {};
    void allreduceAndFactorKKT() override {};
    void assembleKKT() override {}
+   void problem_data_changed() override {};
 
    void Lsolve(Vector<double>&) override {};
    void Dsolve(Vector<double>&) override {};
@@ -14,6 +14,8 @@
 
 #include "omp.h"
 
+#include <vector>
+
 /** This class solves the linear system corresponding to a leaf node.
  *  It just redirects the call to SparseLinearSystem.
  */
@@ -24,7 +26,7 @@ public:
       std::shared_ptr<Vector<double>> primal_reg_, std::shared_ptr<Vector<double>> dual_y_reg_,
       std::shared_ptr<Vector<double>> dual_z_reg_, std::shared_ptr<Vector<double>> rhs_);
 
-   ~DistributedLeafLinearSystem() override = default;
+   ~DistributedLeafLinearSystem() override;
 
    void factor2() override;
 
@@ -32,6 +34,8 @@ public:
 
    void allreduceAndFactorKKT() override { factor2(); };
 
+   void problem_data_changed() override;
+
    void Lsolve(Vector<double>&) override {};
 
    void Dsolve(Vector<double>& x) override;
@@ -70,6 +74,8 @@ public:
 
 protected:
    void create_kkt();
+   /* (re-)puts Qi, Bi and Di into kkt - the pattern of kkt stays as it is */
+   void put_problem_blocks();
 
    void add_regularization_diagonal(int offset, double regularization, Vector<double>& regularization_vector);
 
@@ -89,6 +95,30 @@ private:
    void addLeftBorderKiInvBrToRes(AbstractMatrix& result, BorderBiBlock& Bl, BorderLinsys& Br,
       std::vector<BorderMod>& Br_mod_border, bool sparse_res,
       bool sym_res, int begin_cols_br, int end_cols_br, int begin_cols_res, int end_cols_res);
+
+   /* cached contribution Bi^T Ki^-1 Bi of this leaf to the schur complement - see option SC_REUSE_LEAF_CONTRIBUTION_TOL;
+    * it only has entries in the rows and columns of the schur complement the border of this leaf touches, only those are kept */
+   const double sc_contribution_reuse_tol{};
+   const size_t sc_contribution_max_bytes{};
+   /* size of the schur complement the cache was set up for, -1 if not set up */
+   long long sc_contribution_sc_size{-1};
+   /* false if the contribution of this leaf did not fit into SC_REUSE_LEAF_CONTRIBUTION_MAX_MB */
+   bool sc_contribution_cached{false};
+   /* sorted touched rows/columns of the schur complement */
+   std::vector<int> sc_contribution_indices;
+   /* sparse schur complement only : positions of the touched entries in its values */
+   std::vector<int> sc_contribution_positions;
+   /* the touched entries - dense : all of indices x indices, row major; sparse : in the order of positions */
+   std::vector<double> sc_contribution;
+   /* diagonal of kkt at the time sc_contribution was computed */
+   std::vector<double> sc_contribution_kkt_diagonal;
+   size_t accounted_sc_contribution_bytes{0};
+
+   void setupSCContribution(bool sparseSC, const SymmetricMatrix& SC, const BorderBiBlock& border);
+   [[nodiscard]] bool scContributionReusable(const DenseVector<double>& kkt_diagonal) const;
+   /* calls f(entry of SC, entry of sc_contribution) for all touched entries */
+   template<typename F>
+   void forEachSCContributionEntry(bool sparseSC, SymmetricMatrix& SC, const F& f);
 };
 
 #endif
@@ -18,10 +18,13 @@
 
 #include "RACFG_BLOCK.h"
 #include "BorderMod_Block.h"
+#include "StochResourcesMonitor.hpp"
 
 #include <vector>
 #include <memory>
 #include <tuple>
+#include <map>
+#include <array>
 
 #include "mpi.h"
 
@@ -31,8 +34,6 @@ class DistributedFactory;
 
 class DistributedProblem;
 
-class StochNodeResourcesMonitor;
-
 class DistributedLinearSystem : public LinearSystem {
 
 public:
@@ -41,7 +42,7 @@ public:
    DistributedLinearSystem(const DistributedFactory& factory, DistributedProblem* prob, std::shared_ptr<Vector<double>> dd, std::shared_ptr<Vector<double>> dq, std::shared_ptr<Vector<double>> nomegaInv,
          std::shared_ptr<Vector<double>> primal_reg_, std::shared_ptr<Vector<double>> dual_y_reg_, std::shared_ptr<Vector<double>> dual_z_reg_, std::shared_ptr<Vector<double>> rhs, bool create_iter_ref_vecs);
 
-   ~DistributedLinearSystem() override = default;
+   ~DistributedLinearSystem() override;
 
    void factorize(const Variables& variables) override;
 
@@ -83,6 +84,16 @@ protected:
    std::vector<int> colId;
    std::vector<int> colSparsity;
 
+   /* the non-empty columns of each part of a border, ordered by the first KKT row they touch */
+   struct BorderColumnOrder {
+      std::vector<int> RAC;
+      std::vector<int> F;
+      std::vector<int> G;
+   };
+   /* the structure of the borders does not change during the solve - computed once per border and kept */
+   std::map<std::tuple<const SparseMatrix*, const SparseMatrix*, const SparseMatrix*, const SparseMatrix*, const SparseMatrix*>, BorderColumnOrder> border_column_orders;
+   const BorderColumnOrder& getBorderColumnOrder(const BorderBiBlock& border);
+
    /* is this linsys the overall root */
    const bool is_hierarchy_root{false};
 
@@ -95,6 +106,11 @@ public:
    const DistributedTree* distributed_tree{};
    StochNodeResourcesMonitor* resource_monitor{};
 protected:
+   /* bytes of the factorization of solver currently registered with the MemoryMonitor */
+   size_t accounted_solver_bytes{0};
+   /* re-register the memory held by solver after a (re-)factorization */
+   void updateSolverMemoryAccounting(MemoryCategory category);
+
    /* depending on SC_HIERARCHICAL_COMPUTE_BLOCKWISE either allocated a full buffer of buffer_m rows or a smaller one - returns number of rows in buffer */
    int allocateAndZeroBlockedComputationsBuffer(int buffer_m, int buffer_n);
 
@@ -184,11 +200,22 @@ protected:
    void addLeftBorderTimesDenseColsToResTransp(const BorderBiBlock& Bl, const double* cols, const int* cols_id, int length_col, int n_cols,
          bool sparse_res, bool sym_res, AbstractMatrix& res) const;
 
-   static void addLeftBorderTimesDenseColsToResTranspSparse(const BorderBiBlock& Bl, const double* cols, const int* cols_id, int length_col, int n_cols,
-         SparseSymmetricMatrix& res) ;
+   void addLeftBorderTimesDenseColsToResTranspSparse(const BorderBiBlock& Bl, const double* cols, const int* cols_id, int length_col, int n_cols,
+         SparseSymmetricMatrix& res) const;
+
+   /* for each row of a sparse (transposed) result, the rows of the R, A, C, F and G blocks of a left border that add to it and the
+    * positions in the result's values they go to - built the first time a row is assembled, afterwards assembly only scatters */
+   struct SCScatterMap {
+      int res_nonzeros{-1};
+      std::vector<char> row_mapped;
+      std::vector<std::array<std::vector<int>, 5>> rows;
+      std::vector<std::array<std::vector<int>, 5>> positions;
+   };
+   mutable std::map<std::tuple<const SparseStorage*, const SparseMatrix*, const SparseMatrix*, const SparseMatrix*, const SparseMatrix*, const SparseMatrix*>, SCScatterMap> sc_scatter_maps;
+   SCScatterMap& getSCScatterMap(const BorderBiBlock& Bl, const SparseSymmetricMatrix& res) const;
 
-   void addLeftBorderTimesDenseColsToResTranspDense(const BorderBiBlock& Bl, const double* cols, const int* cols_id, int length_col, int n_cols,
-         int n_cols_res, double** res) const;
+   static void addLeftBorderTimesDenseColsToResTranspDense(const BorderBiBlock& Bl, const double* cols, const int* cols_id, int length_col, int n_cols,
+         int n_cols_res, double** res);
 
    /* calculate res -= BT0 * X0 */
    void finalizeDenseBorderBlocked(BorderLinsys& B, const DenseMatrix& X, DenseMatrix& result, int begin_rows, int end_rows);
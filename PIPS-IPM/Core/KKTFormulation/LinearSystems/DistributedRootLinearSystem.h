@@ -30,6 +30,19 @@ protected:
 
    void print_solver_regularization_and_sc_info(const std::string&& name) const;
 
+   /* bytes of the assembled Schur complement - for a sparse one this is its maximal symbolic structure */
+   [[nodiscard]] size_t schurComplementBytes() const;
+   /* estimate for the bytes the root solver will allocate in its factorization - a lower bound for sparse solvers */
+   [[nodiscard]] size_t predictedSolverBytes() const;
+
+   /* sums elements[0, length) over mpiComm without blocking - the elements must not be accessed before finishB0Reductions */
+   void startB0Reduction(double* elements, int length);
+   /* waits for all reductions started since the last call; prints the overlap per solve if PRINT_B0_REDUCTION_OVERLAP */
+   void finishB0Reductions();
+   void reportB0ReductionOverlap(const std::string& name) const;
+
+   std::vector<MPI_Request> b0_reductions;
+
 private:
    void init();
 
@@ -49,6 +62,8 @@ public:
 
    void allreduceAndFactorKKT() override;
 
+   void problem_data_changed() override;
+
    /* Atoms methods of FACTOR2 for a non-leaf linear system */
    virtual void initializeKKT();
 
@@ -116,16 +131,19 @@ public:
 
    void allreduceMatrix(AbstractMatrix& mat, bool is_sparse, bool is_sym, MPI_Comm comm);
 
-   static void
-   submatrixAllReduceFull(DenseSymmetricMatrix& A, int startRow, int startCol, int nRows, int nCols, MPI_Comm comm);
+   /* node_leaders_only: only the node leaders of comm get the reduced values, see NodeTopology::allreduceSumToNodeLeaders */
+   static void submatrixAllReduceFull(DenseSymmetricMatrix& A, int startRow, int startCol, int nRows, int nCols, MPI_Comm comm,
+      bool node_leaders_only = false);
 
    static void submatrixAllReduceFull(DenseMatrix& A, int startRow, int startCol, int nRows, int nCols, MPI_Comm comm);
 
    // all_reduces specified submatrix as a while
-   static void submatrixAllReduceFull(double** A, int startRow, int startCol, int nRows, int nCols, MPI_Comm comm);
+   static void submatrixAllReduceFull(double** A, int startRow, int startCol, int nRows, int nCols, MPI_Comm comm,
+      bool node_leaders_only = false);
 
    // all_reducees lower half (including diagonal) of specified submatrix
-   static void submatrixAllReduceDiagLower(DenseSymmetricMatrix& A, int substart, int subsize, MPI_Comm comm);
+   static void submatrixAllReduceDiagLower(DenseSymmetricMatrix& A, int substart, int subsize, MPI_Comm comm,
+      bool node_leaders_only = false);
 
    SCsparsifier precondSC;
 
@@ -144,6 +162,7 @@ protected: //buffers
    Vector<double>* zDiagLinkCons{};
 
    double* sparseKktBuffer{};
+   size_t accounted_kkt_bytes{0};
 
    std::unique_ptr<DistributedVector<double>> sol_inner{};
 
@@ -152,6 +171,8 @@ protected: //buffers
    bool hasSparseKkt;
    bool usePrecondDist;
    bool allreduce_kkt;
+   /* dense factor kept once per node (SC_DENSE_SHARED_FACTOR_PER_NODE) - only the node leaders need the reduced Schur complement */
+   bool dense_factor_shared_on_node{false};
 
 private:
    void initProperChildrenRange();
@@ -52,6 +52,6 @@ Regularization FriedlanderOrbanRegularization::get_regularization_parameters() {
    }
 }
 
-Regularization FriedlanderOrbanRegularization::get_default_regularization() {
+Regularization FriedlanderOrbanRegularization::get_default_regularization(double) {
    return get_regularization_parameters();
 }
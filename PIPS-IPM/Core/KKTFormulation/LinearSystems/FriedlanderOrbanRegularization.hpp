@@ -11,7 +11,7 @@ class FriedlanderOrbanRegularization : public RegularizationStrategy {
 public:
    FriedlanderOrbanRegularization(unsigned int positive_eigenvalues_expected, unsigned int negaitve_eigenvalues_expected, MPI_Comm mpi_comm = MPI_COMM_WORLD);
 
-   [[nodiscard]] Regularization get_default_regularization() override;
+   [[nodiscard]] Regularization get_default_regularization(double barrier_parameter) override;
    Regularization get_regularization_parameters(const Inertia&, double) override;
 
    ~FriedlanderOrbanRegularization() override = default;
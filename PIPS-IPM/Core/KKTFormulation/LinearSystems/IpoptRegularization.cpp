@@ -13,7 +13,8 @@ IpoptRegularization::IpoptRegularization(unsigned int positive_eigenvalues_expec
    unsigned int negaitve_eigenvalues_expected, MPI_Comm mpi_comm) :
    RegularizationStrategy(positive_eigenvalues_expected, negaitve_eigenvalues_expected, mpi_comm),
    primal_regularization_absolute_minimum{pipsipmpp_options::get_double_parameter("IPOPT_REGULARIZATION_MIN_PRIMAL")},
-   primal_regularization_absolute_maximum{pipsipmpp_options::get_double_parameter("IPOPT_REGULARIZATION_MAX_PRIMAL")} {
+   primal_regularization_absolute_maximum{pipsipmpp_options::get_double_parameter("IPOPT_REGULARIZATION_MAX_PRIMAL")},
+   warm_start{pipsipmpp_options::get_bool_parameter("IPOPT_REGULARIZATION_WARM_START")} {
 }
 
 void IpoptRegularization::notify_new_step() {
@@ -21,13 +22,36 @@ void IpoptRegularization::notify_new_step() {
    if (primal_regularization_current != -1.0) {
       primal_regularization_last = primal_regularization_current;
    }
+
+   corrected_last_step = corrections_current_step > 0;
+   corrections_current_step = 0;
 }
 
-Regularization IpoptRegularization::get_default_regularization() {
+Regularization IpoptRegularization::get_default_regularization(double barrier_parameter) {
+   /* the unregularized matrix of this block had wrong inertia last time - most likely it still has, so skip that factorization
+    * and start with a decreased version of the last regularization; once that works right away we try without again */
+   if (warm_start && corrected_last_step) {
+      assert(primal_regularization_last > 0.0);
+      new_factorization = false;
+      primal_regularization_current = std::max(primal_regularization_absolute_minimum,
+         primal_regularization_decrease_factor * primal_regularization_last);
+      /* the dual term of the last step belongs to the last barrier parameter */
+      dual_equality_regularization_current = dual_regularization(zero_eigenvalues_last_correction, barrier_parameter);
+      dual_inequality_regularization_current = dual_equality_regularization_current;
+
+      if (pipsipmpp_options::get_bool_parameter("REGULARIZATION_VERBOSE") && PIPS_MPIgetRank(mpi_comm) == 0) {
+         std::cout << "IPOPT regularization: warm starting with regularization : " << primal_regularization_current
+            << " " << dual_equality_regularization_current << " " << dual_inequality_regularization_current << "\n";
+      }
+      return {primal_regularization_current, dual_equality_regularization_current, dual_inequality_regularization_current};
+   }
+
    return {0.0, 0.0, 0.0};
 }
 
 Regularization IpoptRegularization::get_regularization_parameters(const Inertia& inertia, double barrier_parameter) {
+   ++corrections_current_step;
+
    if (new_factorization) {
       new_factorization = false;
       return get_regularization_new_matrix(inertia, barrier_parameter);
@@ -44,12 +68,8 @@ Regularization IpoptRegularization::get_regularization_new_matrix(const Inertia&
 
    assert(positive_eigenvalues != positive_eigenvalues_expected || negative_eigenvalues != negative_eigenvalues_expected);
 
-   if (zero_eigenvalues) {
-      dual_equality_regularization_current = std::pow(barrier_parameter, barrier_exponent_dual);
-   }
-   else {
-      dual_equality_regularization_current = 1e-4;
-   }
+   zero_eigenvalues_last_correction = zero_eigenvalues > 0;
+   dual_equality_regularization_current = dual_regularization(zero_eigenvalues_last_correction, barrier_parameter);
 
    if (primal_regularization_last == 0.0) {
       primal_regularization_current = primal_regularization_initial;
@@ -91,3 +111,7 @@ Regularization IpoptRegularization::get_regularization_nth_try(const Inertia& in
 
    return {primal_regularization_current, dual_equality_regularization_current, dual_inequality_regularization_current};
 }
+
+double IpoptRegularization::dual_regularization(bool zero_eigenvalues, double barrier_parameter) {
+   return zero_eigenvalues ? std::pow(barrier_parameter, barrier_exponent_dual) : 1e-4;
+}
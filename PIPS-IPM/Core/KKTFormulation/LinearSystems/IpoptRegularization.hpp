@@ -12,12 +12,13 @@ public:
    IpoptRegularization(unsigned int positive_eigenvalues_expected, unsigned int negaitve_eigenvalues_expected, MPI_Comm mpi_comm = MPI_COMM_WORLD);
    ~IpoptRegularization() override = default;
 
-   [[nodiscard]] Regularization get_default_regularization() override;
+   [[nodiscard]] Regularization get_default_regularization(double barrier_parameter) override;
    Regularization get_regularization_parameters(const Inertia& inertia, double barrier_parameter) override;
    void notify_new_step() override;
 private:
    Regularization get_regularization_new_matrix(const Inertia& inertia, double barrier_parameter);
    Regularization get_regularization_nth_try(const Inertia& inertia, double barrier_parameter);
+   [[nodiscard]] static double dual_regularization(bool zero_eigenvalues, double barrier_parameter);
 
    constexpr static double barrier_exponent_dual{0.25};
 
@@ -28,8 +29,16 @@ private:
 
    const double primal_regularization_absolute_minimum{};
    const double primal_regularization_absolute_maximum{};
+   const bool warm_start{};
 
    double primal_regularization_last{0.0};
+
+   /* number of inertia corrections in the current step and whether the previous step needed any - each block of the
+    * distributed KKT system has its own strategy, so this is cached per block */
+   unsigned int corrections_current_step{0};
+   bool corrected_last_step{false};
+   /* whether the last correction found zero eigenvalues - its dual regularization then depends on the barrier parameter */
+   bool zero_eigenvalues_last_correction{false};
 };
 
 #endif //PIPSIPMPP_IPOPTREGULARIZATION_HPP
@@ -190,6 +190,8 @@ public:
  */
    void solve(const Variables& variables, const Residuals& residuals, Variables& step) override;
 
+   void problem_data_changed() override;
+
    /** assembles a single vector object from three given vectors
     *
     * @param rhs (output) final joined vector
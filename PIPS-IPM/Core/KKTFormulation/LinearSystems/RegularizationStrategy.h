@@ -18,7 +18,7 @@ public:
 
    [[nodiscard]] bool is_inertia_correct(const Inertia& inertia) const;
    virtual void notify_new_step();
-   [[nodiscard]] virtual Regularization get_default_regularization() = 0;
+   [[nodiscard]] virtual Regularization get_default_regularization(double barrier_parameter) = 0;
    virtual Regularization get_regularization_parameters(const Inertia& inertia, double barrier_parameter) = 0;
 
    virtual ~RegularizationStrategy() = default;
@@ -29,6 +29,9 @@ public:
 
    void addTermToSparseSchurCompl(SparseSymmetricMatrix& SC) override;
 
+   /** not supported - the Schur solvers copy the off-diagonal values of kkt and the borders only once */
+   void problem_data_changed() override;
+
 private:
    bool switchedToSafeSlv{false};
 
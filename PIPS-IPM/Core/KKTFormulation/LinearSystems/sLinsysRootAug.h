@@ -48,6 +48,7 @@ protected:
          bool sparse_res) override;
    void addBlTKiInvBrToResBlockwise(AbstractMatrix& result, BorderLinsys& Bl, BorderLinsys& Br, std::vector<BorderMod>& Br_mod_border, bool sym_res,
          bool sparse_res, DenseMatrix& buffer_b0, int begin_cols, int end_cols);
+   void clearReducedB0Parts(DenseVector<double>& b0) const;
 
 private:
    void finalizeKKTdense();
@@ -2,7 +2,9 @@
 #include "Variables.h"
 #include "Problem.hpp"
 #include "pipsdef.h"
+#include "StochResourcesMonitor.hpp"
 
+#include <array>
 #include <iostream>
 #include <utility>
 
@@ -23,11 +25,15 @@ Residuals::Residuals(std::unique_ptr<Vector<double>> rQ_, std::unique_ptr<Vector
    rt{std::move(rt_)}, ru{std::move(ru_)}, rgamma{std::move(rgamma_)},
    rphi{std::move(rphi_)},
    rlambda{std::move(rlambda_)}, rpi{std::move(rpi_)} {
+   accounted_bytes = memory_footprint();
+   MemoryMonitor::allocate(MemoryCategory::ITERATES, accounted_bytes);
 }
 
 Residuals::Residuals(const Residuals& residuals) : residual_norm{residuals.residual_norm},
    duality_gap{residuals.duality_gap},
-   primal_objective{residuals.primal_objective}, dual_objective{residuals.dual_objective}, nx{residuals.nx},
+   primal_objective{residuals.primal_objective}, dual_objective{residuals.dual_objective},
+   primal_objective_curvature{residuals.primal_objective_curvature}, complementarity{residuals.complementarity},
+   complementarity_curvature{residuals.complementarity_curvature}, nx{residuals.nx},
    my{residuals.my}, mz{residuals.mz},
    ixupp{residuals.ixupp}, nxupp{residuals.nxupp}, ixlow{residuals.ixlow}, nxlow{residuals.nxlow},
    icupp{residuals.icupp}, mcupp{residuals.mcupp}, iclow{residuals.iclow}, mclow{residuals.mclow},
@@ -36,7 +42,24 @@ Residuals::Residuals(const Residuals& residuals) : residual_norm{residuals.resid
    rw{residuals.rw->clone_full()},
    rt{residuals.rt->clone_full()}, ru{residuals.ru->clone_full()}, rgamma{residuals.rgamma->clone_full()},
    rphi{residuals.rphi->clone_full()},
-   rlambda{residuals.rlambda->clone_full()}, rpi{residuals.rpi->clone_full()} {}
+   rlambda{residuals.rlambda->clone_full()}, rpi{residuals.rpi->clone_full()} {
+   accounted_bytes = memory_footprint();
+   MemoryMonitor::allocate(MemoryCategory::ITERATES, accounted_bytes);
+}
+
+Residuals::~Residuals() {
+   MemoryMonitor::release(MemoryCategory::ITERATES, accounted_bytes);
+}
+
+size_t Residuals::memory_footprint() const {
+   size_t bytes = 0;
+   for (const auto* vec : {lagrangian_gradient.get(), equality_residuals.get(), inequality_residuals.get(), inequality_dual_residuals.get(),
+      rv.get(), rw.get(), rt.get(), ru.get(), rgamma.get(), rphi.get(), rlambda.get(), rpi.get()}) {
+      if (vec)
+         bytes += vec->memory_footprint();
+   }
+   return bytes;
+}
 
 std::unique_ptr<Residuals> Residuals::clone_full() const {
    return std::make_unique<Residuals>(*this);
@@ -60,17 +83,35 @@ void Residuals::evaluate(const Problem& problem, const Variables& iterate, bool
 
    this->residual_norm = 0.0;
    this->duality_gap = 0.0;
-   this->primal_objective = problem.evaluate_objective(iterate);
    this->dual_objective = 0.0;
 
    /*** rQ = Qx + g - A^T y - C^T z - gamma + phi ***/
-   problem.evaluate_objective_gradient(iterate, *this->lagrangian_gradient); // Qx + g
-
-   // contribution calculate x^T (g + Qx) to duality gap */
-   this->duality_gap = this->lagrangian_gradient->dotProductWith(*iterate.primals);
+   problem.get_objective_gradient(*this->lagrangian_gradient);
+   problem.lagrangian_gradient_mult(1.0, *this->lagrangian_gradient, 1.0, *iterate.primals, -1.0, *iterate.equality_duals, -1.0,
+      *iterate.inequality_duals);
 
-   problem.ATransmult(1.0, *this->lagrangian_gradient, -1.0, *iterate.equality_duals);
-   problem.CTransmult(1.0, *this->lagrangian_gradient, -1.0, *iterate.inequality_duals);
+   /*** rA = Ax - b, rC = Cx - s ***/
+   problem.getbA(*this->equality_residuals);
+   this->inequality_residuals->copyFrom(*iterate.slacks);
+   problem.constraint_mult(-1.0, *this->equality_residuals, -1.0, *this->inequality_residuals, 1.0, *iterate.primals);
+
+   /* x^T (Qx + g) = x^T (rQ + A^T y + C^T z) = x^T rQ + y^T (rA + b) + z^T (rC + s) - all local parts are reduced at once,
+    * together with the complementarity */
+   std::array<double, 7> dot_products{this->lagrangian_gradient->local_dot_product_with(*iterate.primals),
+      this->equality_residuals->local_dot_product_with(*iterate.equality_duals),
+      problem.equality_rhs->local_dot_product_with(*iterate.equality_duals),
+      this->inequality_residuals->local_dot_product_with(*iterate.inequality_duals),
+      iterate.slacks->local_dot_product_with(*iterate.inequality_duals), problem.objective_gradient->local_dot_product_with(*iterate.primals),
+      local_complementarity(iterate, iterate)};
+   PIPS_MPIsumArrayInPlace(dot_products.data(), static_cast<int>(dot_products.size()), iterate.primals->communicator());
+
+   const auto[x_rQ, y_rA, ba_y, z_rC, z_s, g_x, gap_dual] = dot_products;
+   const double x_Qx_g = x_rQ + y_rA + ba_y + z_rC + z_s;
+   this->complementarity = gap_dual;
+
+   // contribution x^T (g + Qx) to duality gap
+   this->duality_gap = x_Qx_g;
+   this->primal_objective = 0.5 * (x_Qx_g + g_x);
 
    if (nxlow > 0) {
       this->lagrangian_gradient->add(-1.0, *iterate.primal_lower_bound_gap_dual);
@@ -81,21 +122,12 @@ void Residuals::evaluate(const Problem& problem, const Variables& iterate, bool
    }
 
    this->residual_norm = std::max(this->residual_norm, compute_inf_norm(*this->lagrangian_gradient, print_residuals, "rQ"));
-
-   /*** rA = Ax - b ***/
-   problem.getbA(*this->equality_residuals);
-   problem.Amult(-1.0, *this->equality_residuals, 1.0, *iterate.primals);
    this->residual_norm = std::max(this->residual_norm, compute_inf_norm(*this->equality_residuals, print_residuals, "rA"));
 
    // contribution -d^T y to duality gap
-   const double ba_y = problem.equality_rhs->dotProductWith(*iterate.equality_duals);
    this->duality_gap -= ba_y;
    this->dual_objective += ba_y;
 
-   /*** rC = Cx - s ***/
-   this->inequality_residuals->copyFrom(*iterate.slacks);
-   problem.Cmult(-1.0, *this->inequality_residuals, 1.0, *iterate.primals);
-
    this->residual_norm = std::max(this->residual_norm, compute_inf_norm(*this->inequality_residuals, print_residuals, "rC"));
 
    /*** rz = z - lambda + pi ***/
@@ -171,50 +203,186 @@ void Residuals::evaluate(const Problem& problem, const Variables& iterate, bool
 }
 
 double Residuals::compute_residual_norm() {
-   residual_norm = 0.0;
+   /* max over the local parts of all components first - then one reduction instead of one per component */
+   residual_norm = std::max(lagrangian_gradient->local_inf_norm(), equality_residuals->local_inf_norm());
+   residual_norm = std::max(residual_norm, inequality_residuals->local_inf_norm());
+   residual_norm = std::max(residual_norm, inequality_dual_residuals->local_inf_norm());
 
-   double componentNorm = 0.0;
-   componentNorm = lagrangian_gradient->inf_norm();
+   if (mclow > 0)
+      residual_norm = std::max(residual_norm, rt->local_inf_norm());
+   if (mcupp > 0)
+      residual_norm = std::max(residual_norm, ru->local_inf_norm());
+   if (nxlow > 0)
+      residual_norm = std::max(residual_norm, rv->local_inf_norm());
+   if (nxupp > 0)
+      residual_norm = std::max(residual_norm, rw->local_inf_norm());
 
-   if (componentNorm > residual_norm)
-      residual_norm = componentNorm;
+   PIPS_MPIgetMaxInPlace(residual_norm, lagrangian_gradient->communicator());
+   return residual_norm;
+}
+
+void Residuals::evaluate_step_change(const Problem& problem, const Variables& iterate, const Variables& step, Residuals& dual_change) {
+   /*** primal part ***/
+   /* d rQ = Q dx */
+   lagrangian_gradient->setToZero();
+   problem.hessian_multiplication(0.0, *lagrangian_gradient, 1.0, *step.primals);
+
+   /* b'y + d'lambda - f'pi + lx'gamma - ux'phi is linear in the duals */
+   double b_dy = problem.equality_rhs->local_dot_product_with(*step.equality_duals);
+   if (mclow > 0)
+      b_dy += problem.inequality_lower_bounds->local_dot_product_with(*step.slack_lower_bound_gap_dual);
+   if (mcupp > 0)
+      b_dy -= problem.inequality_upper_bounds->local_dot_product_with(*step.slack_upper_bound_gap_dual);
+   if (nxlow > 0)
+      b_dy += problem.primal_lower_bounds->local_dot_product_with(*step.primal_lower_bound_gap_dual);
+   if (nxupp > 0)
+      b_dy -= problem.primal_upper_bounds->local_dot_product_with(*step.primal_upper_bound_gap_dual);
+
+   /* objective 1/2 x'Qx + g'x and duality gap contribution x'(g + Qx) are quadratic along the step, the complementarity is bilinear in the
+    * primal and dual step length - all local parts are reduced at once */
+   std::array<double, 7> dot_products{problem.objective_gradient->local_dot_product_with(*step.primals),
+      lagrangian_gradient->local_dot_product_with(*iterate.primals), lagrangian_gradient->local_dot_product_with(*step.primals), b_dy,
+      local_complementarity(step, iterate), local_complementarity(iterate, step), local_complementarity(step, step)};
+   PIPS_MPIsumArrayInPlace(dot_products.data(), static_cast<int>(dot_products.size()), iterate.primals->communicator());
+
+   const auto[g_dx, x_Q_dx, dx_Q_dx, dual_objective_change, dgap_dual, gap_ddual, dgap_ddual] = dot_products;
+   this->primal_objective_curvature = dx_Q_dx;
+   this->primal_objective = g_dx + x_Q_dx;
+   this->duality_gap = g_dx + 2.0 * x_Q_dx;
+   this->dual_objective = 0.0;
+   this->complementarity = dgap_dual;
+   this->complementarity_curvature = dgap_ddual;
 
-   componentNorm = equality_residuals->inf_norm();
-   if (componentNorm > residual_norm)
-      residual_norm = componentNorm;
+   /* d rA = A dx, d rC = C dx - ds */
+   equality_residuals->setToZero();
+   inequality_residuals->copyFrom(*step.slacks);
+   problem.constraint_mult(0.0, *equality_residuals, -1.0, *inequality_residuals, 1.0, *step.primals);
 
-   componentNorm = inequality_residuals->inf_norm();
-   if (componentNorm > residual_norm)
-      residual_norm = componentNorm;
+   inequality_dual_residuals->setToZero();
 
    if (mclow > 0) {
-      componentNorm = rt->inf_norm();
-      if (componentNorm > residual_norm)
-         residual_norm = componentNorm;
+      /* d rt = ds - dt */
+      rt->copyFrom(*step.slacks);
+      rt->selectNonZeros(*iclow);
+      rt->add(-1.0, *step.slack_lower_bound_gap);
    }
 
    if (mcupp > 0) {
-      componentNorm = ru->inf_norm();
-      if (componentNorm > residual_norm)
-         residual_norm = componentNorm;
+      /* d ru = ds + du */
+      ru->copyFrom(*step.slacks);
+      ru->selectNonZeros(*icupp);
+      ru->add(1.0, *step.slack_upper_bound_gap);
    }
 
-   componentNorm = inequality_dual_residuals->inf_norm();
-   if (componentNorm > residual_norm)
-      residual_norm = componentNorm;
-
    if (nxlow > 0) {
-      componentNorm = rv->inf_norm();
-      if (componentNorm > residual_norm)
-         residual_norm = componentNorm;
+      /* d rv = dx - dv */
+      rv->copyFrom(*step.primals);
+      rv->selectNonZeros(*ixlow);
+      rv->add(-1.0, *step.primal_lower_bound_gap);
    }
 
    if (nxupp > 0) {
-      componentNorm = rw->inf_norm();
-      if (componentNorm > residual_norm)
-         residual_norm = componentNorm;
+      /* d rw = dx + dw */
+      rw->copyFrom(*step.primals);
+      rw->selectNonZeros(*ixupp);
+      rw->add(1.0, *step.primal_upper_bound_gap);
    }
-   return residual_norm;
+
+   /*** dual part ***/
+   /* d rQ = - A^T dy - C^T dz - dgamma + dphi */
+   dual_change.lagrangian_gradient->setToZero();
+   problem.lagrangian_gradient_mult(1.0, *dual_change.lagrangian_gradient, 0.0, *step.primals, -1.0, *step.equality_duals, -1.0,
+      *step.inequality_duals);
+   if (nxlow > 0)
+      dual_change.lagrangian_gradient->add(-1.0, *step.primal_lower_bound_gap_dual);
+   if (nxupp > 0)
+      dual_change.lagrangian_gradient->add(1.0, *step.primal_upper_bound_gap_dual);
+
+   /* d rz = dz - dlambda + dpi */
+   dual_change.inequality_dual_residuals->copyFrom(*step.inequality_duals);
+   if (mclow > 0)
+      dual_change.inequality_dual_residuals->add(-1.0, *step.slack_lower_bound_gap_dual);
+   if (mcupp > 0)
+      dual_change.inequality_dual_residuals->add(1.0, *step.slack_upper_bound_gap_dual);
+
+   dual_change.equality_residuals->setToZero();
+   dual_change.inequality_residuals->setToZero();
+   if (mclow > 0)
+      dual_change.rt->setToZero();
+   if (mcupp > 0)
+      dual_change.ru->setToZero();
+   if (nxlow > 0)
+      dual_change.rv->setToZero();
+   if (nxupp > 0)
+      dual_change.rw->setToZero();
+
+   dual_change.primal_objective = 0.0;
+   dual_change.primal_objective_curvature = 0.0;
+   dual_change.dual_objective = dual_objective_change;
+   dual_change.duality_gap = -dual_objective_change;
+   dual_change.complementarity = gap_ddual;
+   dual_change.complementarity_curvature = 0.0;
+}
+
+void Residuals::evaluate_along_step(const Residuals& base, const Residuals& primal_change, const Residuals& dual_change, double alpha_primal,
+   double alpha_dual) {
+   lagrangian_gradient->copyFrom(*base.lagrangian_gradient);
+   lagrangian_gradient->add(alpha_primal, *primal_change.lagrangian_gradient);
+   lagrangian_gradient->add(alpha_dual, *dual_change.lagrangian_gradient);
+
+   equality_residuals->copyFrom(*base.equality_residuals);
+   equality_residuals->add(alpha_primal, *primal_change.equality_residuals);
+
+   inequality_residuals->copyFrom(*base.inequality_residuals);
+   inequality_residuals->add(alpha_primal, *primal_change.inequality_residuals);
+
+   inequality_dual_residuals->copyFrom(*base.inequality_dual_residuals);
+   inequality_dual_residuals->add(alpha_dual, *dual_change.inequality_dual_residuals);
+
+   if (mclow > 0) {
+      rt->copyFrom(*base.rt);
+      rt->add(alpha_primal, *primal_change.rt);
+   }
+   if (mcupp > 0) {
+      ru->copyFrom(*base.ru);
+      ru->add(alpha_primal, *primal_change.ru);
+   }
+   if (nxlow > 0) {
+      rv->copyFrom(*base.rv);
+      rv->add(alpha_primal, *primal_change.rv);
+   }
+   if (nxupp > 0) {
+      rw->copyFrom(*base.rw);
+      rw->add(alpha_primal, *primal_change.rw);
+   }
+
+   const double curvature = primal_change.primal_objective_curvature;
+   primal_objective = base.primal_objective + alpha_primal * primal_change.primal_objective + 0.5 * alpha_primal * alpha_primal * curvature;
+   dual_objective = base.dual_objective + alpha_dual * dual_change.dual_objective;
+   duality_gap = base.duality_gap + alpha_primal * primal_change.duality_gap + alpha_primal * alpha_primal * curvature +
+      alpha_dual * dual_change.duality_gap;
+   complementarity = base.complementarity + alpha_primal * primal_change.complementarity + alpha_dual * dual_change.complementarity +
+      alpha_primal * alpha_dual * primal_change.complementarity_curvature;
+
+   compute_residual_norm();
+}
+
+double Residuals::local_complementarity(const Variables& gaps, const Variables& duals) const {
+   double result = 0.0;
+   if (mclow > 0)
+      result += gaps.slack_lower_bound_gap->local_dot_product_with(*duals.slack_lower_bound_gap_dual);
+   if (mcupp > 0)
+      result += gaps.slack_upper_bound_gap->local_dot_product_with(*duals.slack_upper_bound_gap_dual);
+   if (nxlow > 0)
+      result += gaps.primal_lower_bound_gap->local_dot_product_with(*duals.primal_lower_bound_gap_dual);
+   if (nxupp > 0)
+      result += gaps.primal_upper_bound_gap->local_dot_product_with(*duals.primal_upper_bound_gap_dual);
+   return result;
+}
+
+double Residuals::get_mu() const {
+   const long long number_complementarity_pairs = mclow + mcupp + nxlow + nxupp;
+   return number_complementarity_pairs == 0 ? 0.0 : complementarity / static_cast<double>(number_complementarity_pairs);
 }
 
 void Residuals::add_to_complementarity_residual(const Variables& variables, double alpha) {
@@ -312,6 +480,11 @@ int Residuals::valid_non_zero_pattern() const {
 void Residuals::copy(const Residuals& residuals) {
    residual_norm = residuals.residual_norm;
    duality_gap = residuals.duality_gap;
+   primal_objective = residuals.primal_objective;
+   dual_objective = residuals.dual_objective;
+   primal_objective_curvature = residuals.primal_objective_curvature;
+   complementarity = residuals.complementarity;
+   complementarity_curvature = residuals.complementarity_curvature;
 
    nx = residuals.nx;
    my = residuals.my;
@@ -363,7 +536,9 @@ void Residuals::write_to_stream(std::ostream& out) const {
 }
 
 double Residuals::constraint_violation() const {
-   return equality_residuals->one_norm() + inequality_residuals->one_norm();
+   double violation = equality_residuals->local_one_norm() + inequality_residuals->local_one_norm();
+   PIPS_MPIgetSumInPlace(violation, equality_residuals->communicator());
+   return violation;
 }
 
 double Residuals::optimality_measure(/*Problem& problem, Variables& iterate, Scaler& scaler*/) const {
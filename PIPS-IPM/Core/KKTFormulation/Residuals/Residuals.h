@@ -53,6 +53,12 @@ protected:
    double duality_gap{std::numeric_limits<double>::infinity()};
    double primal_objective{std::numeric_limits<double>::infinity()};
    double dual_objective{std::numeric_limits<double>::infinity()};
+   /* dx' * Q * dx - only set on the primal part of a step change, see evaluate_step_change */
+   double primal_objective_curvature{0.};
+   /* t'lambda + u'pi + v'gamma + w'phi - per unit step on the parts of a step change */
+   double complementarity{std::numeric_limits<double>::infinity()};
+   /* dt'dlambda + du'dpi + dv'dgamma + dw'dphi - only set on the primal part of a step change */
+   double complementarity_curvature{0.};
 
    long long nx{-1};
    long long my{-1};
@@ -70,8 +76,14 @@ protected:
    std::shared_ptr<Vector<double>> iclow;
    long long mclow{-1};
 
+   /* bytes registered with the MemoryMonitor on construction */
+   size_t accounted_bytes{0};
+
    Residuals() = default;
 
+   /* local part of the pairwise products of the bound gaps of gaps and the bound duals of duals */
+   [[nodiscard]] double local_complementarity(const Variables& gaps, const Variables& duals) const;
+
 public:
    std::unique_ptr<Vector<double>> lagrangian_gradient; //rQ
    std::unique_ptr<Vector<double>> equality_residuals; //rA
@@ -96,6 +108,8 @@ public:
       std::shared_ptr<Vector<double>> icupp_);
 
    Residuals(const Residuals& residuals);
+   /* assigning would carry over the other object's accounted_bytes - use copy() for values */
+   Residuals& operator=(const Residuals&) = delete;
 
    [[nodiscard]] virtual std::unique_ptr<Residuals> clone_full() const;
 
@@ -113,9 +127,28 @@ public:
 
    [[nodiscard]] double get_dual_objective() const { return dual_objective; };
 
+   /** the average complementarity product - Variables::mu() of the iterate, without a reduction of its own */
+   [[nodiscard]] double get_mu() const;
+
    /** calculate residuals, their norms, and duality/complementarity gap, given a problem and variable set.  */
    void evaluate(const Problem& problem, const Variables& iterate_in, bool print_residuals = false);
 
+   /** calculate the change of the (linear) residuals, the objective, the duality gap and the complementarity per unit step along step
+    *  at iterate.
+    *  This receives the part caused by the primal components of step (including the Q * dx term), dual_change the part caused by the
+    *  dual components. All matrix-vector products and reductions needed to evaluate residuals along step are done here, once per
+    *  direction - the scalar products all go into a single reduction.
+    */
+   void evaluate_step_change(const Problem& problem, const Variables& iterate, const Variables& step, Residuals& dual_change);
+
+   /** set the residuals, their norm, the objectives, the duality gap and the complementarity to their values at
+    *  iterate + (alpha_primal, alpha_dual) * step, where base has been evaluated at iterate and primal_change, dual_change were
+    *  computed by evaluate_step_change for step.
+    *  Only vector updates and a single reduction for the residual norm - the complementarity residual vectors are not touched.
+    */
+   void evaluate_along_step(const Residuals& base, const Residuals& primal_change, const Residuals& dual_change, double alpha_primal,
+      double alpha_dual);
+
    /** Modify the "complementarity" component of the residuals, by
    * adding the pairwise products of the complementary variables plus
    * a constant alpha to this term.
@@ -146,8 +179,12 @@ public:
 
    void copy(const Residuals&);
 
-   virtual ~Residuals() = default;
+   /** bytes of the residual vectors held by this process */
+   [[nodiscard]] size_t memory_footprint() const;
+
+   virtual ~Residuals();
 
+   /** recompute the inf norm of the linear residuals from the local norms with a single reduction */
    double compute_residual_norm();
 
    int valid_non_zero_pattern() const;
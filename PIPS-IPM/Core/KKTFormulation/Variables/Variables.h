@@ -73,6 +73,8 @@ public:
       std::shared_ptr<Vector<double>> icupp_in);
 
    Variables(const Variables& vars);
+   /* assigning would carry over the other object's accounted_bytes - use copy() for values */
+   Variables& operator=(const Variables&) = delete;
 
    [[nodiscard]] virtual std::unique_ptr<Variables> clone_full() const;
    /** computes mu = (t'lambda +u'pi + v'gamma + w'phi)/(mclow+mcupp+nxlow+nxupp) */
@@ -159,7 +161,14 @@ public:
 
    void set_to_zero();
 
-   virtual ~Variables() = default;
+   /** bytes of the iterate vectors held by this process */
+   [[nodiscard]] size_t memory_footprint() const;
+
+   virtual ~Variables();
+
+private:
+   /* bytes registered with the MemoryMonitor on construction */
+   size_t accounted_bytes{0};
 };
 
 #endif
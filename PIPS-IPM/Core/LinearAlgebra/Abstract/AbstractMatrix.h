@@ -174,6 +174,12 @@ public:
    virtual void rowScale(const Vector<double>& vec) = 0;
    virtual void scalarMult(double num) = 0;
 
+   /** does M have the same dimensions and sparsity pattern as this matrix */
+   [[nodiscard]] virtual bool hasSameNonZeroPattern(const AbstractMatrix& /*M*/) const { assert(false && "not implemented"); return false; };
+   /** overwrite the values of this matrix with the ones of M - returns false if M's sparsity pattern differs from this one's
+    * in which case the values copied so far are not reverted; check hasSameNonZeroPattern first to leave this untouched */
+   virtual bool copyValuesFrom(const AbstractMatrix& /*M*/) { assert(false && "not implemented"); return false; };
+
    [[nodiscard]] virtual std::pair<long long,long long> n_rows_columns() const = 0;
    [[nodiscard]] virtual long long n_rows() const = 0;
    [[nodiscard]] virtual long long n_columns() const = 0;
@@ -295,6 +301,18 @@ public:
       assert(0 && "not implemented");
    };
 
+   /** getRowMinMaxVec for the minimum and the maximum at once - matrices that can do both in one sweep (and reduction) override this */
+   virtual void getRowMinAndMaxVec(bool initializeVec, const Vector<double>* colScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const {
+      getRowMinMaxVec(true, initializeVec, colScaleVec, minVec);
+      getRowMinMaxVec(false, initializeVec, colScaleVec, maxVec);
+   };
+
+   /** getColMinMaxVec for the minimum and the maximum at once */
+   virtual void getColMinAndMaxVec(bool initializeVec, const Vector<double>* rowScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const {
+      getColMinMaxVec(true, initializeVec, rowScaleVec, minVec);
+      getColMinMaxVec(false, initializeVec, rowScaleVec, maxVec);
+   };
+
    /** add absolute value sum of each row to vector */
    virtual void addRowSums(Vector<double>& /*first*/ ) const { assert(0 && "not implemented"); };
 
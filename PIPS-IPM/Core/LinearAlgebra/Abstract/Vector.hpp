@@ -30,6 +30,9 @@ public:
    /** Return the length of this vector. */
    int length() const { return n; }
 
+   /** Return the bytes of entries this process stores for the vector. */
+   [[nodiscard]] virtual size_t memory_footprint() const { return static_cast<size_t>(n) * sizeof(T); }
+
    Vector(int n_);
 
    Vector() = default;
@@ -52,6 +55,12 @@ public:
    virtual T inf_norm() const = 0;
    /** Return the one norm of this Vector<double> object. */
    virtual T one_norm() const = 0;
+   /** Communicator the local_* results of this Vector have to be reduced over - MPI_COMM_SELF if it lives on one process only */
+   [[nodiscard]] virtual MPI_Comm communicator() const { return MPI_COMM_SELF; };
+   /** Return the infinity norm of the part of this Vector<double> stored on this process - no communication, reduce with max */
+   [[nodiscard]] virtual T local_inf_norm() const = 0;
+   /** Return the one norm of the part of this Vector<double> owned by this process - no communication, reduce with sum */
+   [[nodiscard]] virtual T local_one_norm() const = 0;
 
    /** Return number of elements in this vector not considered zero */
    [[nodiscard]] virtual int getNnzs() const = 0;
@@ -116,6 +125,8 @@ public:
 
    /** Return the dot product of this Vector<double> with v */
    virtual T dotProductWith(const Vector<T>& v) const = 0;
+   /** Return the dot product of the parts of this Vector<double> and v owned by this process - no communication, reduce with sum */
+   [[nodiscard]] virtual T local_dot_product_with(const Vector<T>& v) const = 0;
 
    /** Return the scaled dot product of this (scaled) vector with itself  */
    virtual T dotProductSelf(T scaleFactor) const = 0;
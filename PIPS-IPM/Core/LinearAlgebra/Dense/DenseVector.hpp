@@ -63,6 +63,8 @@ public:
    double two_norm() const override;
    T inf_norm() const override;
    T one_norm() const override;
+   T local_inf_norm() const override { return inf_norm(); };
+   T local_one_norm() const override { return one_norm(); };
    void min(T& m, int& index) const override;
    void max(T& m, int& index) const override;
    void absminVecUpdate(Vector<T>& absminvec) const override;
@@ -95,6 +97,7 @@ public:
    * */
    void gondzioProjection(T rmin, T rmax) override;
    T dotProductWith(const Vector<T>& v) const override;
+   T local_dot_product_with(const Vector<T>& v) const override { return dotProductWith(v); };
    T dotProductSelf(T scaleFactor) const override;
    [[nodiscard]] T scaled_dot_product_self(const Vector<T>& scale) const override;
 
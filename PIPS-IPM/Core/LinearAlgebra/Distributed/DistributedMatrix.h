@@ -59,17 +59,34 @@ private:
 
    /** trans mult method for children with linking constraints */
    virtual void transpose_mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x,
-      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& transpose_mult) const;
+      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& transpose_mult, bool linking_partial) const;
 
    virtual void transpose_mult2(double beta, DistributedVector<double>& y, double alpha, const DistributedVector<double>& x, const Vector<double>* xvecl,
       const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& transpose_mult) const;
 
    virtual void mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x,
-      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const;
+      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult, bool linking_partial) const;
 
    virtual void mult2(double beta, DistributedVector<double>& y, double alpha, const DistributedVector<double>& x, Vector<double>* yparentl_,
       const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const;
 
+   /** can the child loops of mult and transpose_mult be split into a linking and a local phase and run threaded -
+    *  requires all (non-dummy) children to be leaves with sparse blocks and a dense linking vector */
+   [[nodiscard]] bool canSplitChildLoops(const Vector<double>* linking_vec) const;
+
+   /** adds the contributions of all children to linking_vec - each thread accumulates into its own buffer, owned by the call so that
+    *  concurrent products with the same matrix do not share it */
+   template<typename ChildProduct>
+   void accumulateChildLinkingParts(DenseVector<double>& linking_vec, const ChildProduct& child_product) const;
+
+   /** like accumulateChildLinkingParts for the minimum and maximum of the linking elements - child_min_max(child, link_min, link_max)
+    *  computes all statistics of one child, threads run over all children even without linking elements */
+   template<typename ChildMinMax>
+   void accumulateChildLinkingMinMax(DenseVector<double>& link_min, DenseVector<double>& link_max, const ChildMinMax& child_min_max) const;
+
+   /** one MPI_Allreduce for the minima and maxima of linking elements - the minima travel negated */
+   void allreduceLinkingMinMax(DenseVector<double>& link_min, DenseVector<double>& link_max) const;
+
    /** column scale method for children */
    virtual void columnScale2(const Vector<double>& vec);
 
@@ -112,6 +129,8 @@ public:
    void rowScale(const Vector<double>& vec) override;
    void symmetricScale(const Vector<double>&) override { assert("Not implemented" && 0); };
    void scalarMult(double num) override;
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override;
+   bool copyValuesFrom(const AbstractMatrix& M) override;
 
    void fromGetSpRow(int, int, double[], int, int[], int&, int, int&) const override { assert("Not implemented" && 0); };
    void atPutSubmatrix(int, int, const AbstractMatrix&, int, int, int, int) override { assert("Not implemented" && 0); };
@@ -130,6 +149,12 @@ public:
 
    void transpose_mult_transform(double beta, Vector<double>& y, double alpha, const Vector<double>& x, const std::function<double(const double&)>& transform) const override;
 
+   /** as mult and transpose_mult, but the linking part of y (y.last for mult, the linking variables for transpose_mult) holds
+    *  a partial sum per process: it is scaled by beta on every process and never reduced - the caller has to zero it on all but
+    *  one process beforehand and sum it up over the processes afterwards. Allows combining several products into one reduction. */
+   void mult_linking_partial(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const;
+   void transpose_mult_linking_partial(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const;
+
    [[nodiscard]] double inf_norm() const override;
    [[nodiscard]] double abminnormNonZero(double tol) const override;
 
@@ -170,6 +195,10 @@ public:
    /** fill vector with absolute minimum/maximum value of each column */
    void getColMinMaxVec(bool getMin, bool initializeVec, const Vector<double>* rowScaleVec, Vector<double>& minmaxVec) const override;
 
+   /** both of the above in one sweep over each block and one reduction of the linking parts, children are threaded */
+   void getRowMinAndMaxVec(bool initializeVec, const Vector<double>* colScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const override;
+   void getColMinAndMaxVec(bool initializeVec, const Vector<double>* rowScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const override;
+
    void sum_transform_rows(Vector<double>& result, const std::function<double(const double&)>& transform) const override;
    void sum_transform_columns(Vector<double>& result, const std::function<double(const double&)>& transform) const override;
 
@@ -225,6 +254,11 @@ protected:
          Vector<double>* minmax_link_parent) const;
    virtual void getColMinMaxVecChild(bool getMin, bool initializeVec, const Vector<double>* rowScaleVec, const Vector<double>* rowScaleParent,
          Vector<double>& minmaxVec) const;
+   /* the linking rows/columns of a child go to link_min/link_max instead of the parent's vectors - these may be thread private */
+   virtual void getRowMinAndMaxVecChild(bool initializeVec, const Vector<double>* colScaleVec, Vector<double>& minVec, Vector<double>& maxVec,
+         Vector<double>* link_min, Vector<double>* link_max) const;
+   virtual void getColMinAndMaxVecChild(bool initializeVec, const Vector<double>* rowScaleVec, const Vector<double>* rowScaleParent,
+         Vector<double>& minVec, Vector<double>& maxVec, Vector<double>& link_min, Vector<double>& link_max) const;
 
    [[nodiscard]] virtual bool amatEmpty() const;
    virtual void shaveBorder(int m_conss, int n_vars, StripMatrix* border_left, StripMatrix* border_bottom);
@@ -271,6 +305,8 @@ public:
    void columnScale(const Vector<double>&) override {};
    void rowScale(const Vector<double>&) override {};
    void scalarMult(double) override {};
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override { return M.is_a(kStochGenDummyMatrix); };
+   bool copyValuesFrom(const AbstractMatrix& M) override { return M.is_a(kStochGenDummyMatrix); };
 
    void getDiagonal(Vector<double>&) const override {};
    void setToDiagonal(const Vector<double>&) override {};
@@ -283,12 +319,12 @@ public:
       const std::function<double(const double&)>&) const override {};
 private:
    void mult(double, Vector<double>&, double, const Vector<double>&,
-      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const override{};
+      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult, bool) const override{};
    void mult2(double, DistributedVector<double>&, double, const DistributedVector<double>&, Vector<double>*,
       const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const override {};
 
    void transpose_mult(double, Vector<double>&, double, const Vector<double>&,
-      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const override {};
+      const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult, bool) const override {};
    void transpose_mult2(double, DistributedVector<double>&, double, const DistributedVector<double>&, const Vector<double>*,
       const std::function<void(const GeneralMatrix*, double, Vector<double>&, double, const Vector<double>&)>& mult) const override {};
 
@@ -335,6 +371,8 @@ public:
 
    void getRowMinMaxVec(bool, bool, const Vector<double>*, Vector<double>&) const override {};
    void getColMinMaxVec(bool, bool, const Vector<double>*, Vector<double>&) const override {};
+   void getRowMinAndMaxVec(bool, const Vector<double>*, Vector<double>&, Vector<double>&) const override {};
+   void getColMinAndMaxVec(bool, const Vector<double>*, Vector<double>&, Vector<double>&) const override {};
 
    void addRowSums(Vector<double>&, Vector<double>*) const override {};
    void addColSums(Vector<double>&, Vector<double>*) const override {};
@@ -382,6 +420,9 @@ public:
 protected:
    void getRowMinMaxVecChild(bool, bool, const Vector<double>*, Vector<double>&, Vector<double>*) const override {};
    void getColMinMaxVecChild(bool, bool, const Vector<double>*, const Vector<double>*, Vector<double>&) const override {};
+   void getRowMinAndMaxVecChild(bool, const Vector<double>*, Vector<double>&, Vector<double>&, Vector<double>*, Vector<double>*) const override {};
+   void getColMinAndMaxVecChild(bool, const Vector<double>*, const Vector<double>*, Vector<double>&, Vector<double>&, Vector<double>&,
+         Vector<double>&) const override {};
 
    void shaveBorder(int, int, StripMatrix* border_left, StripMatrix* border_bottom) override {
       border_left->addChild(std::make_unique<StringGenDummyMatrix>());
@@ -33,6 +33,8 @@ private:
    virtual void deleteEmptyRowsCols(const Vector<int>& nnzVec, const Vector<int>* linkParent);
    virtual void write_to_streamDenseChild(std::stringstream& out, int offset) const;
 
+   void mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x, bool linking_partial) const;
+
 public:
    DistributedSymmetricMatrix(std::unique_ptr<SymmetricMatrix> diag, std::unique_ptr<GeneralMatrix> border, MPI_Comm mpiComm);
 
@@ -72,6 +74,10 @@ public:
    void mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const override;
    void transpose_mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const override;
 
+   /** as mult, but the linking variables of y hold a partial sum per process: they are scaled by beta on every process and
+    *  never reduced - the caller zeroes them on all but one process beforehand and sums them up afterwards */
+   void mult_linking_partial(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const;
+
    [[nodiscard]] double inf_norm() const override;
    using AbstractMatrix::abminnormNonZero;
    [[nodiscard]] double abminnormNonZero(double tol) const override;
@@ -93,6 +99,8 @@ public:
    void rowScale(const Vector<double>& vec) override;
 
    void scalarMult(double num) override;
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override;
+   bool copyValuesFrom(const AbstractMatrix& M) override;
 
    // note: also used for dummy class!
    virtual void deleteEmptyRowsCols(const Vector<int>& nnzVec) {
@@ -154,6 +162,8 @@ public:
    void columnScale(const Vector<double>&) override {};
    void rowScale(const Vector<double>&) override {};
    void scalarMult(double) override {};
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override { return M.is_a(kStochSymDummyMatrix); };
+   bool copyValuesFrom(const AbstractMatrix& M) override { return M.is_a(kStochSymDummyMatrix); };
 
    BorderedSymmetricMatrix* raiseBorder(int) override {
       assert(0 && "CANNOT SHAVE BORDER OFF OF A DUMMY MATRIX");
@@ -4,8 +4,10 @@
 #include "Vector.hpp"
 #include "DenseVector.hpp"
 #include "mpi.h"
+#include <functional>
 #include <vector>
 #include <memory>
+#include <string>
 
 class DistributedTree;
 
@@ -54,6 +56,7 @@ public:
    void jointCopyTo(Vector<T>& vx, Vector<T>& vy, Vector<T>& vz) const override;
 
    [[nodiscard]] bool isKindOf(int kind) const override;
+   [[nodiscard]] size_t memory_footprint() const override;
    void setToZero() override;
    void setToConstant(T c) override;
    [[nodiscard]] bool isZero() const override;
@@ -63,6 +66,9 @@ public:
    [[nodiscard]] double two_norm() const override;
    [[nodiscard]] T inf_norm() const override;
    [[nodiscard]] T one_norm() const override;
+   [[nodiscard]] MPI_Comm communicator() const override { return mpiComm; };
+   [[nodiscard]] T local_inf_norm() const override;
+   [[nodiscard]] T local_one_norm() const override;
    void min(T& m, int& index) const override;
    void max(T& m, int& index) const override;
    void absminVecUpdate(Vector<T>& absminvec) const override;
@@ -98,6 +104,7 @@ public:
    void add_constant(T c) override;
    void gondzioProjection(T rmin, T rmax) override;
    [[nodiscard]] T dotProductWith(const Vector<T>& v) const override;
+   [[nodiscard]] T local_dot_product_with(const Vector<T>& v) const override;
    [[nodiscard]] T dotProductSelf(T scaleFactor) const override;
    [[nodiscard]] T scaled_dot_product_self(const Vector<T>& scale) const override;
 
@@ -133,6 +140,15 @@ public:
    virtual void permuteLinkingEntries(const std::vector<unsigned int>& permvec);
    [[nodiscard]] virtual std::vector<T> gatherStochVector() const;
 
+   /** visits the parts of the vector held by this process, without any communication - block 0 is the root part, block
+    * 1 + i the part of child i and block 1 + children.size() the linking part; the root and linking parts are only
+    * visited on rank 0 */
+   virtual void forEachLocalBlock(const std::function<void(int block, const T* values, int length)>& visit) const;
+
+   /** collective - every process writes its own blocks (numbered as in forEachLocalBlock) into one binary file with
+    * MPI-IO; the file holds a header, the offset and length of each block and then the values in gatherStochVector order */
+   virtual void writeBlocksToFile(const std::string& file_name) const;
+
    /** remove entries i for which select[i] == 0 */
    void removeEntries(const Vector<int>& select) override;
 
@@ -189,6 +205,7 @@ public:
    void jointCopyTo(Vector<T>&, Vector<T>&, Vector<T>&) const override {};
 
    [[nodiscard]] bool isKindOf(int kind) const override { return kind == kStochDummy || kind == kStochVector; }
+   [[nodiscard]] size_t memory_footprint() const override { return 0; }
    [[nodiscard]] bool isZero() const override { return true; };
    void setToZero() override {};
    void setToConstant(T) override {};
@@ -197,6 +214,9 @@ public:
    [[nodiscard]] double two_norm() const override { return 0.0; }
    [[nodiscard]] T inf_norm() const override { return 0.0; }
    [[nodiscard]] T one_norm() const override { return 0.0; }
+   [[nodiscard]] MPI_Comm communicator() const override { return MPI_COMM_SELF; };
+   [[nodiscard]] T local_inf_norm() const override { return 0.0; }
+   [[nodiscard]] T local_one_norm() const override { return 0.0; }
    void min(T&, int&) const override {};
    void max(T&, int&) const override {};
    void absminVecUpdate(Vector<T>&) const override {};
@@ -232,6 +252,7 @@ public:
    void add_constant(T) override {};
    void gondzioProjection(T, T) override {};
    T dotProductWith(const Vector<T>&) const override { return 0.0; }
+   [[nodiscard]] T local_dot_product_with(const Vector<T>&) const override { return 0.0; }
    T dotProductSelf(T) const override { return 0.0; };
    [[nodiscard]] T scaled_dot_product_self(const Vector<T>&) const override { return 0.0; };
 
@@ -266,6 +287,8 @@ public:
    void permuteVec0Entries(const std::vector<unsigned int>&) override {};
    void permuteLinkingEntries(const std::vector<unsigned int>&) override {};
    [[nodiscard]] std::vector<T> gatherStochVector() const override { return std::vector<T>(0); };
+   void forEachLocalBlock(const std::function<void(int, const T*, int)>&) const override {};
+   void writeBlocksToFile(const std::string&) const override {};
 
    [[nodiscard]] int getSize() const override { return 0; };
    [[nodiscard]] int getNnzs() const override { return 0; };
@@ -25,6 +25,9 @@ private:
    getMinMaxVec(bool getMin, bool initializeVec, const SparseStorage* storage, const Vector<double>* coScaleVec, Vector<double>& minmaxVec);
    static void getMinMaxVec(bool getMin, bool initializeVec, const SparseStorageDynamic* storage_dynamic, const Vector<double>* coScaleVec,
          Vector<double>& minmaxVec);
+   template<typename STORAGE>
+   static void getMinAndMaxVec(bool initializeVec, const STORAGE& storage, const Vector<double>* coScaleVec, Vector<double>& minVec,
+         Vector<double>& maxVec);
 
    std::unique_ptr<SparseStorage> mStorage{};
    std::unique_ptr<SparseStorageDynamic> mStorageDynamic{};
@@ -70,6 +73,8 @@ public:
    void rowScale(const Vector<double>& vec) override;
    void symmetricScale(const Vector<double>& vec) override;
    void scalarMult(double num) override;
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override;
+   bool copyValuesFrom(const AbstractMatrix& M) override;
 
    void fromGetSpRow(int row, int col, double A[], int lenA, int jcolA[], int& nnz, int colExtent, int& info) const override;
    void atPutSubmatrix(int destRow, int destCol, const AbstractMatrix& M, int srcRow, int srcCol, int rowExtent, int colExtent) override;
@@ -83,6 +88,10 @@ public:
    void mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const override;
    void mult_transform(double beta, Vector<double>& y, double alpha, const Vector<double>& x, const std::function<double(const double&)>& transform) const override;
    void multMatSymUpper(double beta, SymmetricMatrix& y, double alpha, const double x[], int yrowstart, int ycolstart) const;
+   /** see SparseStorage::symUpperScatterMap and SparseStorage::multMatSymUpperScattered */
+   void symUpperScatterMap(const SymmetricMatrix& y, int yrow, int ycolstart, std::vector<int>& rows, std::vector<int>& y_positions) const;
+   void multMatSymUpperScattered(SymmetricMatrix& y, double alpha, const double x[], const std::vector<int>& rows,
+         const std::vector<int>& y_positions) const;
 
    void transpose_mult(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const override;
    void transpose_mult_transform(double beta, Vector<double>& y, double alpha, const Vector<double>& x, const std::function<double(const double&)>& transform) const override;
@@ -185,6 +194,8 @@ public:
    void addNnzPerRow(Vector<int>& nnzVec) const;
    void addNnzPerCol(Vector<int>& nnzVec) const;
    void addNnzPerCol(Vector<int>& nnzVec, int begin_cols, int end_cols) const;
+   /** minRowVec[j - begin_cols] = min(minRowVec[j - begin_cols], smallest row index in column j + row_offset) for non-empty columns */
+   void minRowPerCol(Vector<int>& minRowVec, int begin_cols, int end_cols, int row_offset) const;
 
    /** fill vector with absolute minimum/maximum value of each row */
    void getRowMinMaxVec(bool getMin, bool initializeVec, const Vector<double>* colScaleVec, Vector<double>& minmaxVec) const override;
@@ -192,6 +203,9 @@ public:
    /** fill vector with absolute minimum/maximum value of each column */
    void getColMinMaxVec(bool getMin, bool initializeVec, const Vector<double>* rowScaleVec, Vector<double>& minmaxVec) const override;
 
+   void getRowMinAndMaxVec(bool initializeVec, const Vector<double>* colScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const override;
+   void getColMinAndMaxVec(bool initializeVec, const Vector<double>* rowScaleVec, Vector<double>& minVec, Vector<double>& maxVec) const override;
+
    void sum_transform_rows(Vector<double>& result, const std::function<double(const double&)>& transform) const override;
    void sum_transform_columns(Vector<double>& result, const std::function<double(const double&)>& transform) const override;
 
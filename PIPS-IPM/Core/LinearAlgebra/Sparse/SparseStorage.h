@@ -40,6 +40,11 @@ private:
 protected:
    int neverDeleteElts;
 
+   /* frees the current arrays if owned and takes ownership of the new ones */
+   void replaceArrays(int* krowM_new, int* jcolM_new, double* M_new);
+   /* replaces arrays the storage does not own by copies - for restructurings that work in place */
+   void copyLentArrays();
+
 public:
    static int instances;
 
@@ -54,6 +59,9 @@ public:
    SparseStorage(int m_, int n_, int len_, int* krowM_, int* jcolM_, double* M_, int deleteElts = 0);
 
    void copyFrom(int* krowM_, int* jcolM_, double* M_) const;
+   [[nodiscard]] bool hasSameNonZeroPattern(const SparseStorage& other) const;
+   /** copies the values of other if it has the same dimensions and sparsity pattern - returns false and leaves this untouched otherwise */
+   bool copyValuesFrom(const SparseStorage& other);
 
    void shiftRows(int row, int shift, int& info);
 
@@ -138,6 +146,12 @@ public:
    void reduceToLower();
 
    void multMatSymUpper(double beta, SparseStorage& y, double alpha, const double x[], int yrow, int ycolstart) const;
+   /** the rows of this that multMatSymUpper adds to row yrow of y and the positions in y's values they go to - computed
+    *  once, multMatSymUpperScattered then does the same product without searching the row of y */
+   void symUpperScatterMap(const SparseStorage& y, int yrow, int ycolstart, std::vector<int>& rows, std::vector<int>& y_positions) const;
+   /** y_values[y_positions[i]] += alpha * row rows[i] of this * x */
+   void multMatSymUpperScattered(double* y_values, double alpha, const double x[], const std::vector<int>& rows,
+         const std::vector<int>& y_positions) const;
 
    void fromGetColBlock(int col, double* A, int lda, int colExtent, int* colSparsity, bool& allzero) const;
 
@@ -150,6 +164,9 @@ public:
    void addNnzPerRow(int* vec) const { addNnzPerRow(vec, 0, m); };
    void addNnzPerRow(int* vec, int begin_rows, int end_rows) const;
 
+   /** vec[r - begin_rows] = min(vec[r - begin_rows], smallest column index in row r + offset) for non-empty rows */
+   void minColPerRow(int* vec, int begin_rows, int end_rows, int offset) const;
+
    void getLinkVarsNnz(std::vector<int>& vec) const;
 
    void sum_transform_rows(Vector<double>& result, const std::function<double(const double&)>& transform) const override;
@@ -160,6 +177,8 @@ public:
    /** store absolute non-zero minimum/maximum entry of row i and first[i] in first[i];
     *  empty rows get value 0.0 for maximization and <double>::max() for minimization  */
    void getRowMinMaxVec(bool getMin, const double* colScaleVec, double* vec) const;
+   /** getRowMinMaxVec for the minimum and the maximum in one sweep over the matrix */
+   void getRowMinAndMaxVec(const double* colScaleVec, double* minVec, double* maxVec) const;
 
    void permuteRows(const std::vector<unsigned int>& permvec);
    void permuteCols(const std::vector<unsigned int>& permvec);
@@ -122,6 +122,9 @@ public:
    void addNnzPerRow(int* vec) const { addNnzPerRow(vec, 0, m); };
    void addNnzPerRow(int* vec, int begin_rows, int end_rows) const;
 
+   /** vec[r - begin_rows] = min(vec[r - begin_rows], smallest column index in row r + offset) for non-empty rows */
+   void minColPerRow(int* vec, int begin_rows, int end_rows, int offset) const;
+
    void write_to_streamDense(std::ostream& out) const;
    void write_to_streamDenseRow(std::ostream& out, int rowidx) const;
 
@@ -135,6 +138,7 @@ public:
 
    void getRowMaxVec(const double* colScaleVec, double* vec) const;
    void getRowMinMaxVec(bool getMin, const double* colScaleVec, double* vec) const;
+   void getRowMinAndMaxVec(const double* colScaleVec, double* minVec, double* maxVec) const;
    void getRowMinVec(const double* colScaleVec, double* vec) const;
 
 };
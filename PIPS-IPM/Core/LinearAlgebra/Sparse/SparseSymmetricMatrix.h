@@ -50,6 +50,8 @@ public:
    void columnScale(const Vector<double>& vec) override;
    void rowScale(const Vector<double>& vec) override;
    void scalarMult(double num) override;
+   [[nodiscard]] bool hasSameNonZeroPattern(const AbstractMatrix& M) const override;
+   bool copyValuesFrom(const AbstractMatrix& M) override;
 
    void symAtPutSpRow(int col, const double A[], int lenA, const int jcolA[], int& info) override;
 
@@ -13,6 +13,14 @@
 #include <vector>
 #include <memory>
 
+// save diagnostic state
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+
+#include "mpi.h"
+// turn the warnings back on
+#pragma GCC diagnostic pop
+
 /** A linear solver for dense, symmetric indefinite systems
  * @ingroup DenseLinearAlgebra
  * @ingroup LinearSolvers
@@ -22,21 +30,34 @@ public:
    explicit DeSymIndefSolver(const DenseSymmetricMatrix& storage);
    explicit DeSymIndefSolver(const SparseSymmetricMatrix& storage);
 
+   /** the factor lives in one MPI-3 shared memory window of all processes in node_comm (which must be able to share memory):
+    *  only the lowest rank of node_comm factorizes (reading its own copy of the matrix), all others solve with its factor */
+   DeSymIndefSolver(const DenseSymmetricMatrix& storage, MPI_Comm node_comm);
+
    void diagonalChanged(int idiag, int extent) override;
    void matrixChanged() override;
 
    using DoubleLinearSolver::solve;
    void solve(Vector<double>& vec) override;
    void solve(GeneralMatrix& vec) override;
+   void solve(int nrhss, double* rhss, int* colSparsity) override;
 
-   ~DeSymIndefSolver() override = default;
+   ~DeSymIndefSolver() override;
 
    [[nodiscard]] bool reports_inertia() const override { return true; };
    [[nodiscard]] std::tuple<unsigned int, unsigned int, unsigned int> get_inertia() const override;
 
+   [[nodiscard]] size_t memory_footprint() const override {
+      const size_t factor_bytes = factorizes ? static_cast<size_t>(n) * n * sizeof(double) : 0;
+      return factor_bytes + work.capacity() * sizeof(double) + ipiv.capacity() * sizeof(int);
+   };
+
 protected:
 
    void calculate_inertia_from_factorization() const;
+   void factorize();
+   /* makes the factor of the node leader visible to all processes of node_comm */
+   void shareFactor();
 
    /* in PIPS symmetric matrices will be lower diagonal matrices which makes them upper diagonal in fortran access */
    const char fortranUplo = 'U';
@@ -49,6 +70,13 @@ protected:
    std::vector<double> work;
    std::vector<int> ipiv;
 
+   /* shared factor only - MPI_COMM_NULL otherwise */
+   MPI_Comm node_comm{MPI_COMM_NULL};
+   MPI_Win factor_window{MPI_WIN_NULL};
+   /* pivots of the leader, stored behind the factor in the window */
+   int* shared_ipiv{};
+   bool factorizes{true};
+
    mutable int positive_eigenvalues{-1};
    mutable int negative_eigenvalues{-1};
    mutable int zero_eigenvalues{0};
@@ -0,0 +1,89 @@
+#ifndef DESYMPACKEDINDEFSOLVER_H
+#define DESYMPACKEDINDEFSOLVER_H
+
+#include "DoubleLinearSolver.h"
+#include "DenseSymmetricMatrix.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+/** A linear solver for dense, symmetric indefinite systems that keeps its factorization in a tiled lower triangle
+ *  (about n(n+tile_size)/2 doubles instead of n^2). Used for the (potentially large) dense root Schur complement
+ *  where DeSymIndefSolver's full copy of the factor doubles the memory needed next to the Schur complement itself.
+ *
+ *  The factorization is LAPACK's blocked Bunch-Kaufman LDL^T (dsytrf/dlasyf, lower): a panel of tile_size columns
+ *  is factored with pivoting over all remaining rows, the trailing tiles are updated with dgemm. Factor and pivots
+ *  have dsytrf's format, so inertia and solves follow dsytrs.
+ *
+ * @ingroup DenseLinearAlgebra
+ * @ingroup LinearSolvers
+ */
+class DeSymPackedIndefSolver : public DoubleLinearSolver {
+public:
+   explicit DeSymPackedIndefSolver(const DenseSymmetricMatrix& dsm, int tile_size = default_tile_size);
+
+   void diagonalChanged(int idiag, int extent) override;
+   void matrixChanged() override;
+
+   using DoubleLinearSolver::solve;
+   void solve(Vector<double>& vec) override;
+   void solve(GeneralMatrix& vec) override;
+
+   ~DeSymPackedIndefSolver() override = default;
+
+   [[nodiscard]] bool reports_inertia() const override { return true; };
+   [[nodiscard]] std::tuple<unsigned int, unsigned int, unsigned int> get_inertia() const override;
+
+   [[nodiscard]] size_t memory_footprint() const override {
+      return (factor.capacity() + panel.capacity() + work.capacity()) * sizeof(double) + ipiv.capacity() * sizeof(int) +
+         tile_offsets.capacity() * sizeof(size_t);
+   };
+
+   static constexpr int default_tile_size = 128;
+
+protected:
+   const DenseStorage& matrix;
+   const int n;
+   const int tile_size;
+   const int n_tiles;
+
+   /* tiles (I,J), I >= J, of the lower triangle - each stored column major with leading dimension tile_rows(I);
+    * diagonal tiles are square, their upper part is unused */
+   std::vector<double> factor;
+   std::vector<size_t> tile_offsets;
+   /* 1-based pivots as returned by dsytrf */
+   std::vector<int> ipiv;
+
+   /* columns of the current panel and W = L D of the panel, n x tile_size column major each */
+   std::vector<double> panel;
+   std::vector<double> work;
+   int panel_start{0};
+   int panel_width{0};
+
+   [[nodiscard]] int tile_rows(int tile) const { return std::min(tile_size, n - tile * tile_size); };
+
+   /** entry (row, col), col <= row, of the lower triangle - of the current panel while it is factored */
+   [[nodiscard]] double& at(int row, int col) {
+      assert(0 <= col && col <= row && row < n);
+      if (panel_start <= col && col < panel_start + panel_width)
+         return panel[static_cast<size_t>(col - panel_start) * n + row];
+      return tileEntry(row, col);
+   };
+   [[nodiscard]] size_t tileIndex(int row, int col) const {
+      const int I = row / tile_size;
+      const int J = col / tile_size;
+      return tile_offsets[static_cast<size_t>(I) * (I + 1) / 2 + J] + static_cast<size_t>(col - J * tile_size) * tile_rows(I) + (row - I * tile_size);
+   };
+   [[nodiscard]] double& tileEntry(int row, int col) { return factor[tileIndex(row, col)]; };
+   [[nodiscard]] double factorEntry(int row, int col) const { return factor[tileIndex(row, col)]; };
+   [[nodiscard]] double& w(int row, int col) { return work[static_cast<size_t>(col) * n + row]; };
+
+   void factorize();
+   /* factors at most tile_size columns starting at column k0 and updates the trailing matrix - returns the number of columns factored */
+   int factorPanel(int k0, int& info);
+   void updateTrailingTiles(int k0, int n_cols);
+   void solveInPlace(double* b) const;
+};
+
+#endif
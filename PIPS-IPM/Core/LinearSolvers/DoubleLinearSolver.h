@@ -50,6 +50,9 @@ public:
    /** get inertia of last factorized system */
    [[nodiscard]] virtual std::tuple<unsigned int, unsigned int, unsigned int> get_inertia() const = 0;
 
+   /** bytes held by the factorization and the solver's own workspaces (not counting the matrix handed to the solver) */
+   [[nodiscard]] virtual size_t memory_footprint() const { return 0; }
+
    /* override if necessary */
    virtual void solveSynchronized(Vector<double>& x) { solve(x); };
 
@@ -182,6 +182,7 @@ public:
    [[nodiscard]] bool reports_inertia() const override { return true; };
    [[nodiscard]] std::tuple<unsigned int, unsigned int, unsigned int> get_inertia() const override;
 
+   [[nodiscard]] size_t memory_footprint() const override;
 };
 
 #endif
@@ -58,6 +58,11 @@ protected:
    const int max_tries = 4;
    const int n_iterative_refinement = 2;
 
+   /** multiple right hand sides are solved in blocks of at most this many columns per thread */
+   const int max_block_rhs = 64;
+   /** refinement steps on a block before the remaining inexact columns are solved one by one */
+   const int max_block_refinement_steps = 10;
+
    const int ooqp_print_level_warnings = 1000;
    bool print{false};
 
@@ -168,8 +173,15 @@ public:
 
    [[nodiscard]] bool reports_inertia() const override { return true; };
    [[nodiscard]] std::tuple<unsigned int, unsigned int, unsigned int> get_inertia() const override;
+
+   [[nodiscard]] size_t memory_footprint() const override;
 protected:
    void solve(int solveType, Vector<double>& rhs);
+
+   /** solves for the given columns of rhss (leading dimension n) with one multiple rhs MA57CD call followed by blocked iterative refinement */
+   void solveBlock(double* rhss, const int* cols, int ncols);
+   /** R = B - A X for ncols columns stored one after the other - every matrix entry is applied to all columns at once */
+   void blockResiduals(const double* B, const double* X, double* R, int ncols, std::vector<double>& X_rowwise, std::vector<double>& R_rowwise) const;
 //   int* new_iworkn(int dim);
 //   double* new_dworkn(int dim);
 };
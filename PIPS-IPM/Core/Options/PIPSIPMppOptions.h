@@ -23,7 +23,7 @@ enum SolverType {
 };
 
 enum SolverTypeDense {
-   SOLVER_DENSE_SYM_INDEF = 0, SOLVER_DENSE_SYM_INDEF_SADDLE_POINT = 1, SOLVER_DENSE_SYM_PSD = 2
+   SOLVER_DENSE_SYM_INDEF = 0, SOLVER_DENSE_SYM_INDEF_SADDLE_POINT = 1, SOLVER_DENSE_SYM_PSD = 2, SOLVER_DENSE_SYM_INDEF_PACKED = 3
 };
 
 std::ostream& operator<<(std::ostream& os, SolverType solver);
@@ -9,6 +9,8 @@
 
 #include "TerminationStatus.hpp"
 
+#include <cstddef>
+
 class Problem;
 
 class Variables;
@@ -29,6 +31,9 @@ public:
    /** postsolve reduced solution and set original solution accordingly */
    virtual PostsolveStatus postsolve(const Variables& reduced_solution, Variables& original_solution, TerminationStatus result_code) = 0;
 
+   /** bytes of postsolve information stored by this process */
+   [[nodiscard]] virtual size_t memory_footprint() const { return 0; }
+
 protected:
    const Problem& original_problem;
 };
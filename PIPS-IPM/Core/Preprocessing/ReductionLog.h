@@ -0,0 +1,149 @@
+/*
+ * ReductionLog.h
+ *
+ *  Compact, append-only log of the reductions recorded by the StochPostsolver.
+ *
+ *  Every reduction is encoded as one record of a byte stream: a type byte, the varint encoded number of indices,
+ *  doubles and ints, the indices (delta and zigzag encoded against the previous index of the same chunk), the raw
+ *  doubles and the zigzag encoded ints. Records are grouped into chunks that can be decoded independently. Once a
+ *  chunk is full it is sealed and, if the resident part of the log exceeds the spill limit, the oldest sealed chunks
+ *  get written to an unlinked temporary file. Postsolve walks the reductions backwards and thus streams the chunks
+ *  back in reverse; decoded chunks are kept in a small cache.
+ */
+
+#ifndef PIPS_IPM_CORE_QPPREPROCESS_REDUCTIONLOG_H_
+#define PIPS_IPM_CORE_QPPREPROCESS_REDUCTIONLOG_H_
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "SystemType.h"
+
+class ReductionLog {
+public:
+   /// view on one decoded reduction - only valid until the next call to getReduction
+   struct Record {
+      int type;
+
+      const INDEX* indices;
+      unsigned int n_indices;
+      const double* float_values;
+      unsigned int n_float_values;
+      const int* int_values;
+      unsigned int n_int_values;
+
+      [[nodiscard]] const INDEX& index(unsigned int i) const {
+         assert(i < n_indices);
+         return indices[i];
+      }
+      [[nodiscard]] double floatValue(unsigned int i) const {
+         assert(i < n_float_values);
+         return float_values[i];
+      }
+      [[nodiscard]] int intValue(unsigned int i) const {
+         assert(i < n_int_values);
+         return int_values[i];
+      }
+   };
+
+   /// spill_limit_bytes < 0 keeps the whole log in memory, 0 spills every sealed chunk
+   explicit ReductionLog(long long spill_limit_bytes, size_t chunk_bytes = 1 << 20);
+   ~ReductionLog();
+
+   ReductionLog(const ReductionLog&) = delete;
+   ReductionLog& operator=(const ReductionLog&) = delete;
+
+   /// appending a reduction - begin, add its data, finish
+   void beginReduction(int type);
+   void addIndex(const INDEX& index);
+   void addFloatValue(double value);
+   void addIntValue(int value);
+   void finishReduction();
+
+   /// number of finished reductions
+   [[nodiscard]] unsigned int size() const { return n_reductions; };
+
+   [[nodiscard]] Record getReduction(unsigned int reduction) const;
+
+   /// marks a reduction as deleted - getReduction will report type for it from now on
+   void markDeleted(unsigned int reduction, int type);
+
+   /// bytes of the log held in memory (spilled chunks are not counted)
+   [[nodiscard]] size_t memory_footprint() const;
+   [[nodiscard]] size_t spilledBytes() const { return spilled_bytes; };
+
+private:
+   struct Chunk {
+      unsigned int first_reduction{0};
+      unsigned int n_reductions{0};
+      std::vector<uint8_t> payload;
+      size_t payload_size{0};
+      /// offset in spill file - -1 if the chunk is resident
+      long file_offset{-1};
+   };
+
+   struct DecodedChunk {
+      int chunk{-1};
+      unsigned int n_reductions{0};
+      unsigned long long last_used{0};
+
+      std::vector<uint8_t> types;
+      std::vector<INDEX> indices;
+      std::vector<double> float_values;
+      std::vector<int> int_values;
+      std::vector<unsigned int> start_idx_indices;
+      std::vector<unsigned int> start_idx_float_values;
+      std::vector<unsigned int> start_idx_int_values;
+   };
+
+   const long long spill_limit_bytes;
+   const size_t chunk_bytes;
+
+   unsigned int n_reductions{0};
+   /// sealed chunks followed by the open chunk currently written to
+   std::vector<Chunk> chunks;
+   size_t resident_sealed_bytes{0};
+   unsigned int first_resident_chunk{0};
+
+   std::vector<bool> deleted;
+   int deleted_type{-1};
+
+   /// reduction under construction
+   bool in_reduction{false};
+   uint8_t current_type{0};
+   std::vector<INDEX> current_indices;
+   std::vector<double> current_float_values;
+   std::vector<int> current_int_values;
+
+   /// delta encoding state of the open chunk
+   int last_node{0};
+   int last_index{0};
+
+   std::FILE* spill_file{nullptr};
+   size_t spilled_bytes{0};
+
+   mutable std::array<DecodedChunk, 2> cache;
+   mutable unsigned long long cache_clock{0};
+   mutable std::vector<uint8_t> read_buffer;
+
+   void sealOpenChunk();
+   void spillChunk(Chunk& chunk);
+   void openSpillFile();
+
+   [[nodiscard]] unsigned int findChunk(unsigned int reduction) const;
+   const DecodedChunk& decodedChunk(unsigned int chunk_id) const;
+   static void decodeChunk(const uint8_t* payload, size_t payload_size, unsigned int n_reductions_chunk, DecodedChunk& decoded);
+
+   static void encodeVarint(std::vector<uint8_t>& out, uint64_t value);
+   static void encodeSigned(std::vector<uint8_t>& out, int64_t value) { encodeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)); };
+   static uint64_t decodeVarint(const uint8_t*& pos);
+   static int64_t decodeSigned(const uint8_t*& pos) {
+      const uint64_t value = decodeVarint(pos);
+      return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+   };
+};
+
+#endif /* PIPS_IPM_CORE_QPPREPROCESS_REDUCTIONLOG_H_ */
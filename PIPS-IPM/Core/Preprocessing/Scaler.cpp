@@ -54,6 +54,56 @@ void Scaler::unscale_variables(Variables& variables) const {
    variables.slack_upper_bound_gap_dual->componentMult(*scaling_factors_inequalities);
 }
 
+void Scaler::scale_variables(Variables& variables) const {
+   if (!scaling_applied)
+      return;
+
+   assert(scaling_factors_columns);
+   assert(scaling_factors_equalities);
+   assert(scaling_factors_inequalities);
+
+   variables.primals->componentDiv(*scaling_factors_columns);
+   variables.slacks->componentMult(*scaling_factors_inequalities);
+   variables.equality_duals->componentDiv(*scaling_factors_equalities);
+   variables.inequality_duals->componentDiv(*scaling_factors_inequalities);
+   variables.primal_lower_bound_gap->componentDiv(*scaling_factors_columns);
+   variables.primal_lower_bound_gap_dual->componentMult(*scaling_factors_columns);
+   variables.primal_upper_bound_gap->componentDiv(*scaling_factors_columns);
+   variables.primal_upper_bound_gap_dual->componentMult(*scaling_factors_columns);
+   variables.slack_lower_bound_gap->componentMult(*scaling_factors_inequalities);
+   variables.slack_lower_bound_gap_dual->componentDiv(*scaling_factors_inequalities);
+   variables.slack_upper_bound_gap->componentMult(*scaling_factors_inequalities);
+   variables.slack_upper_bound_gap_dual->componentDiv(*scaling_factors_inequalities);
+}
+
+void Scaler::unscale_matrices() const {
+   if (!scaling_applied)
+      return;
+
+   auto [inverse_columns, inverse_equalities, inverse_inequalities] = create_primal_dual_vector_triplet();
+   inverse_columns->copyFrom(*scaling_factors_columns);
+   inverse_equalities->copyFrom(*scaling_factors_equalities);
+   inverse_inequalities->copyFrom(*scaling_factors_inequalities);
+   invertAndRound(false, *inverse_columns);
+   invertAndRound(false, *inverse_equalities);
+   invertAndRound(false, *inverse_inequalities);
+
+   scale_matrices(*inverse_columns, *inverse_equalities, *inverse_inequalities);
+}
+
+void Scaler::rescale_matrices() const {
+   if (scaling_applied)
+      scale_matrices(*scaling_factors_columns, *scaling_factors_equalities, *scaling_factors_inequalities);
+}
+
+void Scaler::scale_matrices(const Vector<double>& factors_columns, const Vector<double>& factors_equalities,
+      const Vector<double>& factors_inequalities) const {
+   A->columnScale(factors_columns);
+   A->rowScale(factors_equalities);
+   C->columnScale(factors_columns);
+   C->rowScale(factors_inequalities);
+}
+
 void Scaler::unscale_residuals(Residuals& residuals) const {
    if (!scaling_applied)
       return;
@@ -163,14 +213,12 @@ void Scaler::applyScaling() const {
    // todo scale Q
    scale_objective();
 
-   // scale A and rhs
-   A->columnScale(*scaling_factors_columns);
-   A->rowScale(*scaling_factors_equalities);
+   scale_matrices(*scaling_factors_columns, *scaling_factors_equalities, *scaling_factors_inequalities);
+
+   // scale rhs of A
    bA->componentMult(*scaling_factors_equalities);
 
-   // scale C and lhs, rhs
-   C->columnScale(*scaling_factors_columns);
-   C->rowScale(*scaling_factors_inequalities);
+   // scale lhs, rhs of C
    rhsC->componentMult(*scaling_factors_inequalities);
    lhsC->componentMult(*scaling_factors_inequalities);
 
@@ -187,10 +235,8 @@ void Scaler::applyScaling() const {
 
 double Scaler::maxRowRatio(Vector<double>& maxvecA, Vector<double>& maxvecC, Vector<double>& minvecA, Vector<double>& minvecC,
       const Vector<double>* colScalevec) const {
-   A->getRowMinMaxVec(true, true, colScalevec, minvecA);
-   A->getRowMinMaxVec(false, true, colScalevec, maxvecA);
-   C->getRowMinMaxVec(true, true, colScalevec, minvecC);
-   C->getRowMinMaxVec(false, true, colScalevec, maxvecC);
+   A->getRowMinAndMaxVec(true, colScalevec, minvecA, maxvecA);
+   C->getRowMinAndMaxVec(true, colScalevec, minvecC, maxvecC);
 
 #ifndef NDEBUG
 
@@ -246,11 +292,8 @@ double Scaler::maxRowRatio(Vector<double>& maxvecA, Vector<double>& maxvecC, Vec
 }
 
 double Scaler::maxColRatio(Vector<double>& maxvec, Vector<double>& minvec, const Vector<double>* rowScaleVecA, const Vector<double>* rowScaleVecC) const {
-   A->getColMinMaxVec(true, true, rowScaleVecA, minvec);
-   C->getColMinMaxVec(true, false, rowScaleVecC, minvec);
-
-   A->getColMinMaxVec(false, true, rowScaleVecA, maxvec);
-   C->getColMinMaxVec(false, false, rowScaleVecC, maxvec);
+   A->getColMinAndMaxVec(true, rowScaleVecA, minvec, maxvec);
+   C->getColMinAndMaxVec(false, rowScaleVecC, minvec, maxvec);
 
 #ifndef NDEBUG
    if (!rowScaleVecA || !rowScaleVecC) {
@@ -43,6 +43,11 @@ public:
    [[nodiscard]] double get_unscaled_objective(double objval) const;
 
    void unscale_variables(Variables& variables) const;
+   /** inverse of unscale_variables - brings an iterate of the unscaled problem into the coordinates of this scaling */
+   void scale_variables(Variables& variables) const;
+   /** undoes / redoes the scaling of A and C in place - matrices lent through FMATBORROW hold the user's values again in between */
+   void unscale_matrices() const;
+   void rescale_matrices() const;
    void unscale_residuals(Residuals& residuals) const;
 
    [[nodiscard]] Vector<double>* get_primal_unscaled(const Vector<double>& primal_solution) const;
@@ -57,6 +62,7 @@ protected:
    void create_scaling_vectors();
    PrimalDualTriplet create_primal_dual_vector_triplet() const;
    void applyScaling() const;
+   void scale_matrices(const Vector<double>& factors_columns, const Vector<double>& factors_equalities, const Vector<double>& factors_inequalities) const;
    virtual void scale_objective() const = 0;
 
    /** get maximum absolute row ratio and write maximum row entries into vectors */
@@ -18,6 +18,7 @@
 #include "SystemType.h"
 #include "StochRowStorage.h"
 #include "StochColumnStorage.h"
+#include "ReductionLog.h"
 
 class StochPostsolver : public Postsolver {
 
@@ -93,6 +94,9 @@ public:
    /// synchronization events
 
    PostsolveStatus postsolve(const Variables& reduced_solution, Variables& original_solution, TerminationStatus result_code) override;
+
+   /// reduction log and marker vectors - the rows and columns in row_storage and col_storage are not counted
+   [[nodiscard]] size_t memory_footprint() const override;
 private:
 
    const int my_rank{PIPS_MPIgetRank()};
@@ -143,16 +147,8 @@ private:
    /// has a column been modified
    std::unique_ptr<DistributedVector<int>> column_marked_modified{};
 
-   /// vectors for storing ints and doubles containting information needed by postsolve
-   std::vector<ReductionType> reductions;
-   std::vector<INDEX> indices;
-   std::vector<unsigned int> start_idx_indices;
-
-   std::vector<double> float_values;
-   std::vector<int> int_values;
-
-   std::vector<unsigned int> start_idx_float_values;
-   std::vector<unsigned int> start_idx_int_values;
+   /// encoded log of all reductions and the ints, doubles and indices needed by postsolve - can spill to a file
+   ReductionLog reduction_log;
 
    StochRowStorage row_storage;
 
@@ -166,6 +162,9 @@ private:
    /// stores which reduction is last bound-tightening on variable
    std::unique_ptr<DistributedVector<int>> last_upper_bound_tightened{};
    std::unique_ptr<DistributedVector<int>> last_lower_bound_tightened{};
+   /// old bound stored with that last bound-tightening - repeated tightenings of a column inherit it without decoding the log
+   std::unique_ptr<DistributedVector<double>> upper_bound_before_tightening{};
+   std::unique_ptr<DistributedVector<double>> lower_bound_before_tightening{};
 
    /// stuff for synchronization in-between processes
    const int length_array_outdated_indicators;
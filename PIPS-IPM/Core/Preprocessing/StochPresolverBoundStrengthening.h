@@ -10,6 +10,9 @@
 
 #include "StochPresolverBase.h"
 
+#include <memory>
+#include <vector>
+
 class StochPresolverBoundStrengthening : public StochPresolverBase {
 public:
    StochPresolverBoundStrengthening(PresolveData& presolve_data, const DistributedProblem& origProb);
@@ -44,11 +47,34 @@ private:
    std::vector<bool> used_linking_eq_row;
    std::vector<bool> used_linking_ineq_row;
 
+   /// round in which a bound of a variable in the row got tightened last - rows that did not change since they were last examined are skipped
+   const std::unique_ptr<DistributedVector<int>> eq_row_changed_in_round;
+   const std::unique_ptr<DistributedVector<int>> ineq_row_changed_in_round;
+   int round{0};
+
+   /* a bound implied by a row - the children only read presolve_data while searching for these and are scanned in parallel, the bounds
+    * get applied afterwards in node order so that postsolve sees them in a deterministic order */
+   struct ImpliedBound {
+      INDEX row;
+      INDEX col;
+      double lbx_new;
+      double ubx_new;
+   };
+
    void resetArrays();
    void communicateLinkingVarBounds();
 
-   bool strenghtenBoundsInNode(SystemType system_type, int node);
-   bool strenghtenBoundsInBlock(SystemType system_type, int node, BlockType block_type);
+   void markRowsOfColumnChanged(const INDEX& col);
+   void markRowsOfColumnChanged(const SparseStorageDynamic& mat_transposed, int col, DenseVector<int>& row_changed_in_round) const;
+   void syncLinkingRowsChanged();
+
+   bool strenghtenBoundsInRoot(SystemType system_type);
+   bool strenghtenBoundsInChildren();
+   void findImpliedBounds(SystemType system_type, int node, std::vector<ImpliedBound>& implied_bounds) const;
+   void findImpliedBounds(SystemType system_type, int node, BlockType block_type, int row, std::vector<ImpliedBound>& implied_bounds) const;
+   bool applyImpliedBounds(int node, const std::vector<ImpliedBound>& implied_bounds);
+
+   [[nodiscard]] const SparseStorageDynamic& getBlock(SystemType system_type, int node, BlockType block_type) const;
 };
 
 
@@ -10,6 +10,8 @@
 
 #include "StochPresolverBase.h"
 
+#include <vector>
+
 class StochPresolverModelCleanup : public StochPresolverBase {
 public:
    StochPresolverModelCleanup(PresolveData& presolve_data, const DistributedProblem& origProb);
@@ -31,11 +33,33 @@ private:
    int fixed_empty_cols_total;
    int removed_rows_total;
 
+   /* reductions found while scanning a node - the scans only read presolve_data and can run in parallel over the children,
+    * the reductions get applied sequentially in node order afterwards so that postsolve sees them in a deterministic order */
+   enum class RowReduction { REMOVE_ROW, REMOVE_UPPER_SIDE, REMOVE_LOWER_SIDE, INFEASIBLE };
+   struct RedundantRow {
+      int row_index;
+      bool linking;
+      RowReduction reduction;
+   };
+   struct TinyEntry {
+      BlockType block_type;
+      int row;
+      int col;
+      /* position of the entry in the row storage before any entry of this node got deleted */
+      int col_index;
+   };
+
    int removeRedundantRows(SystemType system_type);
    int removeRedundantRows(SystemType system_type, int node);
-   int removeRedundantRows(SystemType system_type, int node, bool linking);
+   void findRedundantRows(SystemType system_type, int node, bool linking, std::vector<RedundantRow>& redundant_rows) const;
+   int applyRowReductions(SystemType system_type, int node, const std::vector<RedundantRow>& redundant_rows);
+
    int removeTinyEntriesFromSystem(SystemType system_type);
-   int removeTinyInnerLoop(SystemType system_type, int node, BlockType block_type);
+   void findTinyEntries(SystemType system_type, int node, std::vector<TinyEntry>& tiny_entries) const;
+   void findTinyEntries(SystemType system_type, int node, BlockType block_type, std::vector<int>& n_deleted_in_row,
+         std::vector<TinyEntry>& tiny_entries) const;
+   int deleteTinyEntries(SystemType system_type, int node, const std::vector<TinyEntry>& tiny_entries);
+
    int fixEmptyColumns();
 };
 
@@ -12,6 +12,9 @@
 
 #include <boost/unordered_set.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace rowlib {
    static const double offset_hash_double = 0.127;
 
@@ -87,7 +90,7 @@ class StochPresolverParallelRows : public StochPresolverBase {
 public:
    StochPresolverParallelRows(PresolveData& presolve_data, const DistributedProblem& origProb);
 
-   ~StochPresolverParallelRows();
+   ~StochPresolverParallelRows() override = default;
 
    // remove parallel rows
    bool applyPresolving() override;
@@ -106,61 +109,71 @@ private:
    const SparseStorageDynamic* currDmatTrans{};
    const DenseVector<int>* currNnzRowC{};
 
-   // pointers to the normalized and copied matrix blocks
-   std::unique_ptr<SparseStorageDynamic> norm_Amat{};
-   std::unique_ptr<SparseStorageDynamic> norm_Bmat{};
-   std::unique_ptr<SparseStorageDynamic> norm_Cmat{};
-   std::unique_ptr<SparseStorageDynamic> norm_Dmat{};
-   std::unique_ptr<DenseVector<double>> norm_b{};
-   std::unique_ptr<DenseVector<double>> norm_clow{};
-   std::unique_ptr<DenseVector<double>> norm_cupp{};
-   std::unique_ptr<DenseVector<double>> norm_iclow{};
-   std::unique_ptr<DenseVector<double>> norm_icupp{};
-   std::unique_ptr<DenseVector<double>> norm_factorC{};
-   std::unique_ptr<DenseVector<double>> norm_factorA{};
-
-   // data for the nearly parallel row case
-   std::unique_ptr<DenseVector<int>> rowContainsSingletonVariableA{};
-   std::unique_ptr<DenseVector<int>> rowContainsSingletonVariableC{};
-   std::unique_ptr<DenseVector<double>> singletonCoeffsColParent{};
-   std::unique_ptr<DenseVector<double>> singletonCoeffsColChild{};
-   std::unique_ptr<DenseVector<int>> normNnzRowA{};
-   std::unique_ptr<DenseVector<int>> normNnzRowC{};
-   std::unique_ptr<DenseVector<int>> normNnzColParent{};
-   std::unique_ptr<DenseVector<int>> normNnzColChild{};
-   std::unique_ptr<SparseStorageDynamic> norm_AmatTrans{};
-   std::unique_ptr<SparseStorageDynamic> norm_BmatTrans{};
-   std::unique_ptr<SparseStorageDynamic> norm_CmatTrans{};
-   std::unique_ptr<SparseStorageDynamic> norm_DmatTrans{};
-
-   // number of rows of the A or B block
-   int mA{0};
-   // number of columns of the A or C block
-   int nA{0};
-
-   // unordered set?
-   boost::unordered_set<rowlib::rowWithColInd, boost::hash<rowlib::rowWithColInd> > row_support_hashtable;
-   boost::unordered_set<rowlib::rowWithEntries, boost::hash<rowlib::rowWithEntries> > row_coefficients_hashtable;
-
-   void setNormalizedPointers(int node);
-   void setNormalizedPointersMatrices(int node);
-   void setNormalizedPointersMatrixBounds(int node);
-   void setNormalizedNormFactors(int node);
-   void setNormalizedSingletonFlags(int node);
-   void setNormalizedReductionPointers(int node);
+   /* copied and normalized blocks of a node - they only get read from presolve_data, so the children get set up in parallel, their rows
+    * are compared in node order afterwards */
+   struct NormalizedNode {
+      // pointers to the normalized and copied matrix blocks
+      std::unique_ptr<SparseStorageDynamic> norm_Amat{};
+      std::unique_ptr<SparseStorageDynamic> norm_Bmat{};
+      std::unique_ptr<SparseStorageDynamic> norm_Cmat{};
+      std::unique_ptr<SparseStorageDynamic> norm_Dmat{};
+      std::unique_ptr<DenseVector<double>> norm_b{};
+      std::unique_ptr<DenseVector<double>> norm_clow{};
+      std::unique_ptr<DenseVector<double>> norm_cupp{};
+      std::unique_ptr<DenseVector<double>> norm_iclow{};
+      std::unique_ptr<DenseVector<double>> norm_icupp{};
+      std::unique_ptr<DenseVector<double>> norm_factorC{};
+      std::unique_ptr<DenseVector<double>> norm_factorA{};
+
+      // data for the nearly parallel row case
+      std::unique_ptr<DenseVector<int>> rowContainsSingletonVariableA{};
+      std::unique_ptr<DenseVector<int>> rowContainsSingletonVariableC{};
+      std::unique_ptr<DenseVector<double>> singletonCoeffsColParent{};
+      std::unique_ptr<DenseVector<double>> singletonCoeffsColChild{};
+      std::unique_ptr<DenseVector<int>> normNnzRowA{};
+      std::unique_ptr<DenseVector<int>> normNnzRowC{};
+      std::unique_ptr<DenseVector<int>> normNnzColParent{};
+      std::unique_ptr<DenseVector<int>> normNnzColChild{};
+      std::unique_ptr<SparseStorageDynamic> norm_AmatTrans{};
+      std::unique_ptr<SparseStorageDynamic> norm_BmatTrans{};
+      std::unique_ptr<SparseStorageDynamic> norm_CmatTrans{};
+      std::unique_ptr<SparseStorageDynamic> norm_DmatTrans{};
+
+      // number of rows of the A or B block
+      int mA{0};
+      // number of columns of the A or C block
+      int nA{0};
+
+      // rows sharing a bucket of the support and of the coefficient hash table - they point into the normalized blocks above
+      std::vector<std::vector<rowlib::rowWithEntries>> candidate_rows;
+   };
+
+   /// normalized blocks of the node whose rows currently get compared
+   NormalizedNode curr_norm;
+
+   void findParallelRowCandidates(int node, NormalizedNode& norm) const;
+   void compareParallelRowCandidates(int& nRowElims, int node);
+
+   void setNormalizedPointers(int node, NormalizedNode& norm) const;
+   void setNormalizedPointersMatrices(int node, NormalizedNode& norm) const;
+   void setNormalizedPointersMatrixBounds(int node, NormalizedNode& norm) const;
+   void setNormalizedNormFactors(int node, NormalizedNode& norm) const;
+   void setNormalizedSingletonFlags(int node, NormalizedNode& norm) const;
+   void setNormalizedReductionPointers(int node, NormalizedNode& norm) const;
    void updateExtendedPointersForCurrentNode(int node);
 
-   void removeSingletonVars();
+   void removeSingletonVars(NormalizedNode& norm) const;
    void removeEntry(int colIdx, DenseVector<int>& rowContainsSingletonVar, SparseStorageDynamic& matrix, SparseStorageDynamic& matrixTrans,
-         DenseVector<int>& nnzRow, DenseVector<int>& nnzCol, bool parent);
+         DenseVector<int>& nnzRow, DenseVector<int>& nnzCol, bool parent, NormalizedNode& norm) const;
    double removeEntryInDynamicStorage(SparseStorageDynamic& storage, int row, int col) const;
 
    void normalizeBlocksRowwise(SystemType system_type, SparseStorageDynamic* a_mat, SparseStorageDynamic* b_mat, DenseVector<double>* cupp,
-         DenseVector<double>* clow, DenseVector<double>* icupp, DenseVector<double>* iclow) const;
+         DenseVector<double>* clow, DenseVector<double>* icupp, DenseVector<double>* iclow, DenseVector<double>& norm_factor) const;
    void
    insertRowsIntoHashtable(boost::unordered_set<rowlib::rowWithColInd, boost::hash<rowlib::rowWithColInd> >& rows, const SparseStorageDynamic* Ablock,
-         const SparseStorageDynamic* Bblock, SystemType system_type, const DenseVector<int>* nnz_row_norm, const DenseVector<int>* nnz_row_orig);
-   void compareRowsInCoeffHashTable(int& nRowElims, int it);
+         const SparseStorageDynamic* Bblock, SystemType system_type, const DenseVector<int>* nnz_row_norm, const DenseVector<int>* nnz_row_orig,
+         const NormalizedNode& norm) const;
+   void compareCandidateRows(int& nRowElims, int node, const std::vector<rowlib::rowWithEntries>& candidates);
    bool checkRowsAreParallel(const rowlib::rowWithEntries& row1, const rowlib::rowWithEntries& row2) const;
 
    void tightenOriginalBoundsOfRow1(const INDEX& row1, const INDEX& row2) const;
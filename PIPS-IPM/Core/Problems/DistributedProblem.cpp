@@ -2032,6 +2032,64 @@ double DistributedProblem::evaluate_objective(const Variables& variables) const
    return temp->dotProductWith(*variables.primals);
 }
 
+void DistributedProblem::lagrangian_gradient_mult(double beta, Vector<double>& y_, double alpha_Q, const Vector<double>& x, double alpha_A,
+   const Vector<double>& y_A, double alpha_C, const Vector<double>& y_C) const {
+   auto& y = dynamic_cast<DistributedVector<double>&>(y_);
+
+   /* the linking variables of y become a per process partial sum - all products add their local contributions */
+   if (!y.iAmSpecial)
+      y.first->setToZero();
+
+   if (alpha_Q != 0.0)
+      dynamic_cast<const DistributedSymmetricMatrix&>(*hessian).mult_linking_partial(beta, y, alpha_Q, x);
+   else
+      y.scale(beta);
+
+   dynamic_cast<const DistributedMatrix&>(*equality_jacobian).transpose_mult_linking_partial(1.0, y, alpha_A, y_A);
+   dynamic_cast<const DistributedMatrix&>(*inequality_jacobian).transpose_mult_linking_partial(1.0, y, alpha_C, y_C);
+
+   if (y.iAmDistrib)
+      PIPS_MPIsumArrayInPlace(dynamic_cast<DenseVector<double>&>(*y.first).elements(), y.first->length(), y.mpiComm);
+}
+
+void DistributedProblem::constraint_mult(double beta_A, Vector<double>& y_A_, double beta_C, Vector<double>& y_C_, double alpha,
+   const Vector<double>& x) const {
+   auto& y_A = dynamic_cast<DistributedVector<double>&>(y_A_);
+   auto& y_C = dynamic_cast<DistributedVector<double>&>(y_C_);
+
+   /* the linking rows of y_A and y_C become per process partial sums, reduced together in the end */
+   if (y_A.last && !y_A.iAmSpecial)
+      y_A.last->setToZero();
+   if (y_C.last && !y_C.iAmSpecial)
+      y_C.last->setToZero();
+
+   dynamic_cast<const DistributedMatrix&>(*equality_jacobian).mult_linking_partial(beta_A, y_A, alpha, x);
+   dynamic_cast<const DistributedMatrix&>(*inequality_jacobian).mult_linking_partial(beta_C, y_C, alpha, x);
+
+   const int n_linking_A = y_A.last ? static_cast<int>(y_A.last->length()) : 0;
+   const int n_linking_C = y_C.last ? static_cast<int>(y_C.last->length()) : 0;
+
+   if (!y_A.iAmDistrib || n_linking_A + n_linking_C == 0)
+      return;
+
+   std::vector<double> linking_rows(n_linking_A + n_linking_C);
+   if (n_linking_A > 0) {
+      const double* elements = dynamic_cast<DenseVector<double>&>(*y_A.last).elements();
+      std::copy(elements, elements + n_linking_A, linking_rows.begin());
+   }
+   if (n_linking_C > 0) {
+      const double* elements = dynamic_cast<DenseVector<double>&>(*y_C.last).elements();
+      std::copy(elements, elements + n_linking_C, linking_rows.begin() + n_linking_A);
+   }
+
+   PIPS_MPIsumArrayInPlace(linking_rows, y_A.mpiComm);
+
+   if (n_linking_A > 0)
+      std::copy(linking_rows.begin(), linking_rows.begin() + n_linking_A, dynamic_cast<DenseVector<double>&>(*y_A.last).elements());
+   if (n_linking_C > 0)
+      std::copy(linking_rows.begin() + n_linking_A, linking_rows.end(), dynamic_cast<DenseVector<double>&>(*y_C.last).elements());
+}
+
 void DistributedProblem::printLinkVarsStats() {
    assert(!is_hierarchy_inner_leaf && !is_hierarchy_inner_root && !is_hierarchy_root);
    int n = getLocalnx();
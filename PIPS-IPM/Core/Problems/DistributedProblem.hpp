@@ -152,6 +152,11 @@ public:
 
    double evaluate_objective(const Variables& variables) const override;
 
+   /* Q, A and C are applied block by block with a single reduction of the linking part of the result */
+   void lagrangian_gradient_mult(double beta, Vector<double>& y, double alpha_Q, const Vector<double>& x, double alpha_A,
+      const Vector<double>& y_A, double alpha_C, const Vector<double>& y_C) const override;
+   void constraint_mult(double beta_A, Vector<double>& y_A, double beta_C, Vector<double>& y_C, double alpha, const Vector<double>& x) const override;
+
    void
    cleanUpPresolvedData(const DistributedVector<int>& rowNnzVecA, const DistributedVector<int>& rowNnzVecC,
       const DistributedVector<int>& colNnzVec);
@@ -0,0 +1,359 @@
+#include "HierarchicalAutotuner.hpp"
+#include "DistributedProblem.hpp"
+#include "DistributedTree.h"
+#include "DistributedTreeCallbacks.h"
+#include "NodeTopology.h"
+#include "OoqpBlas.h"
+#include "PIPSIPMppOptions.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <utility>
+
+namespace {
+   /* factor nonzeros per nonzero of a leaf KKT system - rough, but only relative costs matter */
+   constexpr double LEAF_FILL_FACTOR = 5.0;
+   /* deepest hierarchy tried */
+   constexpr int MAX_LAYERS = 4;
+   /* smallest blocksize tried when the leaf buffers have to be computed blockwise */
+   constexpr int MIN_BLOCKSIZE = 20;
+
+   /* repeats kernel until it ran for at least min_time seconds, returns seconds per call */
+   template<typename Kernel>
+   double timeKernel(const Kernel& kernel, double min_time) {
+      int reps = 0;
+      const double t0 = MPI_Wtime();
+      double elapsed = 0.0;
+      do {
+         kernel();
+         ++reps;
+         elapsed = MPI_Wtime() - t0;
+      } while (elapsed < min_time);
+      return elapsed / reps;
+   }
+}
+
+HierarchicalAutotuner::HierarchicalAutotuner(DistributedProblem& problem, MPI_Comm comm) : problem{&problem}, comm{comm},
+   n_procs{PIPS_MPIgetSize(comm)}, my_rank{PIPS_MPIgetRank(comm)} {
+   assert(problem.exploitingLinkStructure());
+}
+
+HierarchicalAutotuner::HierarchicalAutotuner(std::vector<int> node_of_proc) : n_procs{static_cast<int>(node_of_proc.size())},
+   node_of_proc{std::move(node_of_proc)} {
+}
+
+void HierarchicalAutotuner::tune() {
+   collectStructure();
+   calibrate();
+
+   const std::vector<Configuration> candidates = priceCandidates();
+   const Configuration& chosen = cheapest(candidates);
+
+   pipsipmpp_options::set_int_parameter("HIERARCHICAL_APPROACH_N_LAYERS", chosen.n_layers);
+   pipsipmpp_options::set_bool_parameter("HIERARCHICAL_MOVE_A0_TO_DENSE_LAYER", chosen.move_a0_to_dense_layer);
+   pipsipmpp_options::set_bool_parameter("SC_HIERARCHICAL_COMPUTE_BLOCKWISE", chosen.compute_blockwise);
+   pipsipmpp_options::set_int_parameter("SC_BLOCKSIZE_HIERARCHICAL", chosen.blocksize);
+
+   report(candidates, chosen);
+}
+
+std::vector<HierarchicalAutotuner::Configuration> HierarchicalAutotuner::priceCandidates() const {
+   const bool apply_split = pipsipmpp_options::get_bool_parameter("HIERARCHICAL_APPLY_SPLIT");
+   /* without any linking variables left in the sparse layer A0 has to go to the dense layer anyway */
+   const bool a0_must_move = n_sparse_link_vars == 0;
+
+   std::vector<Configuration> candidates;
+   for (int n_layers = 1; n_layers <= (apply_split ? MAX_LAYERS : 1); ++n_layers) {
+      /* more layers than the tree allows would be reduced again by splitTree */
+      if (n_layers > 1 && nSubRoots(static_cast<int>(two_links_per_block.size()), 0, n_procs, n_layers) <= 1)
+         break;
+
+      candidates.push_back(price(n_layers, true));
+      if (!a0_must_move)
+         candidates.push_back(price(n_layers, false));
+   }
+   assert(!candidates.empty());
+   return candidates;
+}
+
+const HierarchicalAutotuner::Configuration& HierarchicalAutotuner::cheapest(const std::vector<Configuration>& candidates) {
+   assert(!candidates.empty());
+   return *std::min_element(candidates.begin(), candidates.end(),
+      [](const Configuration& a, const Configuration& b) { return a.predicted_time < b.predicted_time; });
+}
+
+void HierarchicalAutotuner::collectStructure() {
+   DistributedProblem& problem = *this->problem;
+   const DistributedTree& tree = *problem.stochNode;
+   const size_t n_blocks = problem.children.size();
+   assert(tree.nChildren() == n_blocks);
+
+   const std::vector<int>& two_links_eq = problem.getTwoLinksStartBlockA();
+   const std::vector<int>& two_links_ineq = problem.getTwoLinksStartBlockC();
+   assert(two_links_eq.size() == n_blocks && two_links_ineq.size() == n_blocks);
+
+   two_links_per_block.resize(n_blocks);
+   leaf_sizes.resize(n_blocks);
+
+   double my_kkt_nnz = 0.0;
+   double my_kkt_rows = 0.0;
+   for (size_t block = 0; block < n_blocks; ++block) {
+      two_links_per_block[block] = two_links_eq[block] + two_links_ineq[block];
+
+      const DistributedTree& leaf = *tree.getChildren()[block];
+      leaf_sizes[block] = static_cast<double>(leaf.getN() + leaf.getMY() + leaf.getMZ());
+
+      if (leaf.getCommWorkers() != MPI_COMM_NULL) {
+         int nnzQ, nnzB, nnzD;
+         problem.children[block]->getLocalNnz(nnzQ, nnzB, nnzD);
+         my_kkt_nnz += nnzQ + nnzB + nnzD + leaf_sizes[block];
+         my_kkt_rows += leaf_sizes[block];
+      }
+   }
+
+   /* densest leaves of any process */
+   leaf_factor_density = LEAF_FILL_FACTOR * PIPS_MPIgetMax(my_kkt_rows > 0.0 ? my_kkt_nnz / my_kkt_rows : 1.0, comm);
+
+   n_global_links = problem.getNGlobalVars() + problem.getNGlobalEQConss() + problem.getNGlobalINEQConss();
+   n_a0_rows = problem.getLocalmy();
+   n_sparse_link_vars = problem.getLocalnx() - problem.getNGlobalVars();
+   max_sc_nnz = problem.getSchurCompMaxNnz();
+
+   assert(n_global_links >= 0 && n_sparse_link_vars >= 0);
+
+   /* the root of the tree holds the first n_procs ranks, placed as in DistributedTreeCallbacks */
+   const std::vector<int>& node_of_rank = NodeTopology::split(MPI_COMM_WORLD).node_of_rank;
+   node_of_proc.assign(node_of_rank.begin(), node_of_rank.begin() + n_procs);
+}
+
+void HierarchicalAutotuner::calibrate() {
+   constexpr double min_kernel_time = 0.02;
+
+   /* dense - a gemm about the size of the dense layer updates */
+   {
+      int n = 192;
+      std::vector<double> A(n * n, 1.0), B(n * n, 0.5), C(n * n, 0.0);
+      char trans = 'N';
+      double alpha = 1.0;
+      double beta = 0.0;
+      const double time = timeKernel([&]() { dgemm_(&trans, &trans, &n, &n, &n, &alpha, A.data(), &n, B.data(), &n, &beta, C.data(), &n); },
+         min_kernel_time);
+      calibration.dense_rate = 2.0 * n * n * n / time;
+   }
+
+   /* sparse - a CSR product with scattered columns, memory bound like the sparse factor and solve kernels */
+   {
+      const int n = 1 << 17;
+      const int nnz_per_row = 8;
+      std::vector<int> start(n + 1);
+      std::vector<int> cols(n * nnz_per_row);
+      std::vector<double> values(n * nnz_per_row, 1.0);
+      std::vector<double> x(n, 1.0), y(n, 0.0);
+
+      for (int row = 0; row < n; ++row) {
+         start[row] = row * nnz_per_row;
+         for (int k = 0; k < nnz_per_row; ++k)
+            cols[row * nnz_per_row + k] = static_cast<int>((static_cast<long long>(row) * 7919 + k * 104729) % n);
+      }
+      start[n] = n * nnz_per_row;
+
+      const double time = timeKernel([&]() {
+         for (int row = 0; row < n; ++row) {
+            double sum = 0.0;
+            for (int k = start[row]; k < start[row + 1]; ++k)
+               sum += values[k] * x[cols[k]];
+            y[row] = sum;
+         }
+         x[0] = y[n - 1];
+      }, min_kernel_time);
+      calibration.sparse_rate = 2.0 * n * nnz_per_row / time;
+   }
+
+   /* reductions - latency and per element cost of an allreduce over all processes */
+   {
+      constexpr int n_reps = 5;
+      constexpr int n_large = 1 << 16;
+      std::vector<double> buffer(n_large, 1.0);
+
+      MPI_Barrier(comm);
+      double t0 = MPI_Wtime();
+      for (int rep = 0; rep < n_reps; ++rep)
+         PIPS_MPIsumArrayInPlace(buffer.data(), 1, comm);
+      const double latency = (MPI_Wtime() - t0) / n_reps;
+
+      MPI_Barrier(comm);
+      t0 = MPI_Wtime();
+      for (int rep = 0; rep < n_reps; ++rep)
+         PIPS_MPIsumArrayInPlace(buffer.data(), n_large, comm);
+      const double time_large = (MPI_Wtime() - t0) / n_reps;
+
+      calibration.reduce_latency = latency;
+      calibration.reduce_time_per_double = std::max(0.0, time_large - latency) / n_large;
+   }
+
+   /* everyone prices with the slowest process' numbers so that all processes pick the same configuration */
+   calibration.dense_rate = PIPS_MPIgetMin(calibration.dense_rate, comm);
+   calibration.sparse_rate = PIPS_MPIgetMin(calibration.sparse_rate, comm);
+   calibration.reduce_latency = PIPS_MPIgetMax(calibration.reduce_latency, comm);
+   calibration.reduce_time_per_double = PIPS_MPIgetMax(calibration.reduce_time_per_double, comm);
+}
+
+HierarchicalAutotuner::Configuration HierarchicalAutotuner::price(int n_layers, bool move_a0) const {
+   Configuration configuration;
+   configuration.n_layers = n_layers;
+   configuration.move_a0_to_dense_layer = move_a0;
+
+   const double dense_size = n_global_links + (move_a0 ? n_a0_rows : 0);
+   const double extra_root_rows = n_sparse_link_vars + (move_a0 ? 0 : n_a0_rows);
+
+   /* leaf buffers for the dense border columns - computed all at once if they fit into the budget */
+   const double max_leaf_size = *std::max_element(leaf_sizes.begin(), leaf_sizes.end());
+   const double buffer_budget = 1024.0 * 1024.0 * pipsipmpp_options::get_int_parameter("HIERARCHICAL_AUTOTUNE_BUFFER_MB");
+   const double cols_in_budget = std::floor(buffer_budget / (sizeof(double) * std::max(1.0, max_leaf_size)));
+
+   configuration.compute_blockwise = cols_in_budget < dense_size;
+   configuration.blocksize = configuration.compute_blockwise ? std::max(MIN_BLOCKSIZE, static_cast<int>(cols_in_budget))
+      : std::max(MIN_BLOCKSIZE, static_cast<int>(dense_size));
+
+   const double dense_factor = dense_size * dense_size * dense_size / 3.0 / calibration.dense_rate;
+   const double dense_reduce = reduceTime(dense_size * dense_size / 2.0, n_procs);
+
+   /* every block of columns costs a pass through the whole hierarchy */
+   const double n_passes = configuration.compute_blockwise ? std::ceil(dense_size / configuration.blocksize) : 1.0;
+   const double pass_overhead = n_passes * calibration.reduce_latency * n_layers;
+
+   configuration.predicted_time = dense_factor + dense_reduce + pass_overhead +
+      layerTime(0, static_cast<int>(two_links_per_block.size()), n_layers, 0, n_procs, dense_size, extra_root_rows);
+   return configuration;
+}
+
+double HierarchicalAutotuner::layerTime(int begin, int end, int n_layers, int first_proc, int procs, double border_cols,
+   double extra_root_rows) const {
+   assert(begin < end);
+   const int n_blocks = end - begin;
+   const int n_sub_roots = n_layers > 1 ? nSubRoots(n_blocks, first_proc, procs, n_layers) : 1;
+
+   if (n_sub_roots <= 1) {
+      /* root over leafs - the 2-link part of its Schur complement is block tridiagonal, 2-links leaving [begin, end) belong above */
+      double leaf_flops = 0.0;
+      double sc_factor_flops = 0.0;
+      double sc_nnz = 0.0;
+      double sc_rows = extra_root_rows;
+
+      for (int block = begin; block < end; ++block) {
+         const double links = block + 1 < end ? two_links_per_block[block] : 0.0;
+         const double links_prev = block > begin ? two_links_per_block[block - 1] : 0.0;
+
+         leaf_flops += 2.0 * leaf_factor_density * leaf_sizes[block] * (border_cols + extra_root_rows + links + links_prev);
+         sc_factor_flops += (links + links_prev) * (links + links_prev) * links;
+         sc_nnz += links * links + links * links_prev;
+         sc_rows += links;
+      }
+
+      /* the dense rows of the sparse root couple with everything */
+      sc_nnz += extra_root_rows * sc_rows;
+      sc_factor_flops += extra_root_rows * extra_root_rows * extra_root_rows / 3.0 + extra_root_rows * extra_root_rows * (sc_rows - extra_root_rows);
+
+      /* the whole-tree bound from the problem caps the estimate */
+      if (begin == 0 && end == static_cast<int>(two_links_per_block.size()))
+         sc_nnz = std::min(sc_nnz, max_sc_nnz);
+
+      const double leaf_time = leaf_flops / calibration.sparse_rate / std::max(1, procs);
+      const double sc_time = (sc_factor_flops + 2.0 * border_cols * 2.0 * sc_nnz) / calibration.sparse_rate;
+      return leaf_time + sc_time + reduceTime(sc_nnz, procs);
+   }
+
+   /* inner root - 2-links crossing sub-root boundaries stay here and form a small dense Schur complement */
+   double crossing_links = 0.0;
+   double slowest_sub_root = 0.0;
+   const int procs_per_sub_root = std::max(1, procs / n_sub_roots);
+
+   for (int sub_root = 0; sub_root < n_sub_roots; ++sub_root) {
+      const int sub_begin = begin + static_cast<int>(static_cast<long long>(sub_root) * n_blocks / n_sub_roots);
+      const int sub_end = begin + static_cast<int>(static_cast<long long>(sub_root + 1) * n_blocks / n_sub_roots);
+      if (sub_end + 1 <= end && sub_end > sub_begin)
+         crossing_links += two_links_per_block[sub_end - 1];
+   }
+
+   const double inner_rows = crossing_links + extra_root_rows;
+   for (int sub_root = 0; sub_root < n_sub_roots; ++sub_root) {
+      const int sub_begin = begin + static_cast<int>(static_cast<long long>(sub_root) * n_blocks / n_sub_roots);
+      const int sub_end = begin + static_cast<int>(static_cast<long long>(sub_root + 1) * n_blocks / n_sub_roots);
+      /* sub-roots get consecutive processes - or share them if there are fewer processes than sub-roots */
+      const int sub_first_proc = first_proc + (procs >= n_sub_roots ? sub_root * procs_per_sub_root : sub_root * procs / n_sub_roots);
+      if (sub_end > sub_begin)
+         slowest_sub_root = std::max(slowest_sub_root,
+            layerTime(sub_begin, sub_end, n_layers - 1, sub_first_proc, procs_per_sub_root, border_cols + inner_rows, 0.0));
+   }
+
+   /* sub-roots sharing processes run one after the other */
+   const double serialized = procs < n_sub_roots ? static_cast<double>(n_sub_roots) / procs : 1.0;
+   const double inner_time = (inner_rows * inner_rows * inner_rows / 3.0 + 2.0 * border_cols * inner_rows * inner_rows) / calibration.dense_rate;
+
+   return serialized * slowest_sub_root + inner_time + reduceTime(inner_rows * inner_rows / 2.0, procs);
+}
+
+double HierarchicalAutotuner::reduceTime(double n_doubles, int procs) const {
+   if (procs <= 1)
+      return 0.0;
+   /* the calibration reduced over all processes - scale to the tree depth of a reduction over procs processes */
+   const double steps = std::ceil(std::log2(procs)) / std::max(1.0, std::ceil(std::log2(n_procs)));
+   return steps * (calibration.reduce_latency + n_doubles * calibration.reduce_time_per_double);
+}
+
+int HierarchicalAutotuner::nSubRoots(int n_blocks, int first_proc, int procs, int n_layers) const {
+   assert(n_layers > 1);
+   if (n_blocks <= 1 || procs > n_blocks)
+      return 1;
+
+   int n_sub_roots = static_cast<int>(std::floor(std::pow(n_blocks, 1.0 / n_layers)));
+   if (n_sub_roots <= 1)
+      return 1;
+
+   if (procs <= n_sub_roots) {
+      while (n_sub_roots % procs != 0)
+         --n_sub_roots;
+   } else {
+      while (procs % n_sub_roots != 0)
+         --n_sub_roots;
+   }
+
+   /* sub-roots with processes of their own get aligned with the nodes */
+   if (n_sub_roots > 1 && procs > n_sub_roots) {
+      const std::vector<int> node_of_sub_tree_proc(node_of_proc.begin() + first_proc, node_of_proc.begin() + first_proc + procs);
+      n_sub_roots = static_cast<int>(DistributedTreeCallbacks::alignSubTreesWithNodes(node_of_sub_tree_proc, n_sub_roots, n_blocks));
+   }
+   return n_sub_roots;
+}
+
+std::string HierarchicalAutotuner::toString(const Configuration& configuration) {
+   std::ostringstream out;
+   out << "layers " << configuration.n_layers << ", A0 in dense layer " << (configuration.move_a0_to_dense_layer ? "yes" : "no")
+       << ", blockwise " << (configuration.compute_blockwise ? "yes" : "no") << ", blocksize " << configuration.blocksize
+       << " : predicted " << std::scientific << std::setprecision(3) << configuration.predicted_time << " sec. per factorization";
+   return out.str();
+}
+
+void HierarchicalAutotuner::report(const std::vector<Configuration>& candidates, const Configuration& chosen) const {
+   if (my_rank != 0)
+      return;
+
+   std::ostringstream header;
+   header << "Autotuning hierarchical approach: " << two_links_per_block.size() << " blocks, " << n_procs << " processes, "
+          << n_global_links << " global links, " << std::accumulate(two_links_per_block.begin(), two_links_per_block.end(), 0.0)
+          << " 2-links\n";
+   header << "   calibration: dense " << std::scientific << std::setprecision(3) << calibration.dense_rate << " flop/s, sparse "
+          << calibration.sparse_rate << " flop/s, reduction latency " << calibration.reduce_latency << " sec.\n";
+   std::cout << header.str();
+
+   if (!pipsipmpp_options::get_bool_parameter("SILENT")) {
+      for (const Configuration& candidate : candidates)
+         std::cout << "   candidate " << toString(candidate) << "\n";
+   }
+   std::cout << "   chosen    " << toString(chosen) << "\n";
+}
@@ -0,0 +1,90 @@
+#ifndef HIERARCHICALAUTOTUNER_H
+#define HIERARCHICALAUTOTUNER_H
+
+#include "pipsdef.h"
+
+#include <string>
+#include <vector>
+
+class DistributedProblem;
+
+/**
+ * Picks the hierarchical options HIERARCHICAL_APPROACH_N_LAYERS, HIERARCHICAL_MOVE_A0_TO_DENSE_LAYER,
+ * SC_HIERARCHICAL_COMPUTE_BLOCKWISE and SC_BLOCKSIZE_HIERARCHICAL before the hierarchical data gets built.
+ *
+ * Every candidate configuration is priced with a simple model of one KKT factorization: dense factorization and
+ * reduction of the top layer, factorization and reduction of the (block tridiagonal) 2-link Schur complements in the sparse
+ * layers and the leaf solves needed to assemble them. The model is fed with the 2-link structure of the problem and
+ * with dense, sparse and reduction speeds measured in a short calibration run. All inputs are made identical on all
+ * processes, so all processes pick the same configuration.
+ */
+class HierarchicalAutotuner {
+public:
+   HierarchicalAutotuner(DistributedProblem& problem, MPI_Comm comm);
+
+   /** calibrates, prices all candidates, sets the options of the cheapest one and reports it */
+   void tune();
+
+protected:
+   struct Configuration {
+      int n_layers{1};
+      bool move_a0_to_dense_layer{false};
+      bool compute_blockwise{true};
+      int blocksize{20};
+      double predicted_time{0.0};
+   };
+
+   /* measured speeds - flops per second, seconds for a reduction */
+   struct Calibration {
+      double dense_rate{0.0};
+      double sparse_rate{0.0};
+      double reduce_latency{0.0};
+      double reduce_time_per_double{0.0};
+   };
+
+   DistributedProblem* const problem{};
+   const MPI_Comm comm{MPI_COMM_NULL};
+   const int n_procs;
+   const int my_rank{0};
+
+   /* node of each process - splitTree aligns the sub-roots with them */
+   std::vector<int> node_of_proc;
+
+   /* number of 2-link rows starting in each block */
+   std::vector<double> two_links_per_block;
+   /* dimension of each leaf KKT system */
+   std::vector<double> leaf_sizes;
+   /* estimated nonzeros per row in the leaf factors */
+   double leaf_factor_density{0.0};
+
+   int n_global_links{0};
+   int n_a0_rows{0};
+   int n_sparse_link_vars{0};
+   double max_sc_nnz{0.0};
+
+   Calibration calibration;
+
+   /* no problem and no calibration - structure and speeds are filled in directly */
+   explicit HierarchicalAutotuner(std::vector<int> node_of_proc);
+
+   void collectStructure();
+   void calibrate();
+
+   [[nodiscard]] std::vector<Configuration> priceCandidates() const;
+   [[nodiscard]] static const Configuration& cheapest(const std::vector<Configuration>& candidates);
+   [[nodiscard]] Configuration price(int n_layers, bool move_a0) const;
+
+   /* predicted time for the sparse layers below blocks [begin, end) on the procs processes starting at first_proc with border_cols
+    * columns coming from the layers above */
+   [[nodiscard]] double layerTime(int begin, int end, int n_layers, int first_proc, int procs, double border_cols, double extra_root_rows) const;
+   [[nodiscard]] double reduceTime(double n_doubles, int procs) const;
+
+   /* mirrors the number of sub-roots DistributedTreeCallbacks::splitTree will create for the procs processes starting at first_proc,
+    * including their alignment with the nodes */
+   [[nodiscard]] int nSubRoots(int n_blocks, int first_proc, int procs, int n_layers) const;
+
+   void report(const std::vector<Configuration>& candidates, const Configuration& chosen) const;
+   [[nodiscard]] static std::string toString(const Configuration& configuration);
+};
+
+#endif
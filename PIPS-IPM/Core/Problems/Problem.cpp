@@ -44,6 +44,18 @@ void Problem::CTransmult(double beta, Vector<double>& y, double alpha, const Vec
    inequality_jacobian->transpose_mult(beta, y, alpha, x);
 }
 
+void Problem::lagrangian_gradient_mult(double beta, Vector<double>& y, double alpha_Q, const Vector<double>& x, double alpha_A,
+   const Vector<double>& y_A, double alpha_C, const Vector<double>& y_C) const {
+   hessian->mult(beta, y, alpha_Q, x);
+   equality_jacobian->transpose_mult(1.0, y, alpha_A, y_A);
+   inequality_jacobian->transpose_mult(1.0, y, alpha_C, y_C);
+}
+
+void Problem::constraint_mult(double beta_A, Vector<double>& y_A, double beta_C, Vector<double>& y_C, double alpha, const Vector<double>& x) const {
+   equality_jacobian->mult(beta_A, y_A, alpha, x);
+   inequality_jacobian->mult(beta_C, y_C, alpha, x);
+}
+
 void Problem::get_objective_gradient(Vector<double>& myG) const {
    myG.copyFrom(*objective_gradient);
 }
@@ -83,6 +95,42 @@ double Problem::datanorm() const {
    return norm;
 }
 
+bool Problem::has_same_structure(const Problem& other) const {
+   if (nx != other.nx || my != other.my || mz != other.mz)
+      return false;
+
+   /* which bounds exist determines the structure of the iterates and of the linear systems */
+   const auto same_indicators = [](const Vector<double>& indicators, const Vector<double>& other_indicators) {
+      return indicators.matchesNonZeroPattern(other_indicators) && other_indicators.matchesNonZeroPattern(indicators);
+   };
+
+   return same_indicators(*primal_lower_bound_indicators, *other.primal_lower_bound_indicators) &&
+      same_indicators(*primal_upper_bound_indicators, *other.primal_upper_bound_indicators) &&
+      same_indicators(*inequality_lower_bound_indicators, *other.inequality_lower_bound_indicators) &&
+      same_indicators(*inequality_upper_bound_indicators, *other.inequality_upper_bound_indicators) &&
+      hessian->hasSameNonZeroPattern(*other.hessian) && equality_jacobian->hasSameNonZeroPattern(*other.equality_jacobian) &&
+      inequality_jacobian->hasSameNonZeroPattern(*other.inequality_jacobian);
+}
+
+bool Problem::copy_values_from(const Problem& other) {
+   if (!has_same_structure(other))
+      return false;
+
+   const bool copied = hessian->copyValuesFrom(*other.hessian) && equality_jacobian->copyValuesFrom(*other.equality_jacobian) &&
+      inequality_jacobian->copyValuesFrom(*other.inequality_jacobian);
+   assert(copied);
+   (void) copied;
+
+   objective_gradient->copyFrom(*other.objective_gradient);
+   equality_rhs->copyFrom(*other.equality_rhs);
+   primal_lower_bounds->copyFrom(*other.primal_lower_bounds);
+   primal_upper_bounds->copyFrom(*other.primal_upper_bounds);
+   inequality_lower_bounds->copyFrom(*other.inequality_lower_bounds);
+   inequality_upper_bounds->copyFrom(*other.inequality_upper_bounds);
+
+   return true;
+}
+
 void Problem::print() {
    std::cout << "begin Q\n";
    hessian->write_to_stream(std::cout);
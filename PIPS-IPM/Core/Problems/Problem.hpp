@@ -66,6 +66,12 @@ public:
    /** compute the norm of the problem data */
    [[nodiscard]] virtual double datanorm() const;
 
+   /** does other have the same bound indicators and matrix sparsity patterns - other's values may differ */
+   [[nodiscard]] bool has_same_structure(const Problem& other) const;
+
+   /** overwrite the data with the values of other - returns false and leaves the data untouched if other does not have the same structure */
+   bool copy_values_from(const Problem& other);
+
    /** print the problem data */
    virtual void print();
 
@@ -102,6 +108,13 @@ public:
    /** y = beta * y + alpha * C\T * x */
    virtual void CTransmult(double beta, Vector<double>& y, double alpha, const Vector<double>& x) const;
 
+   /** y = beta * y + alpha_Q * Q * x + alpha_A * A\T * y_A + alpha_C * C\T * y_C */
+   virtual void lagrangian_gradient_mult(double beta, Vector<double>& y, double alpha_Q, const Vector<double>& x, double alpha_A,
+      const Vector<double>& y_A, double alpha_C, const Vector<double>& y_C) const;
+
+   /** y_A = beta_A * y_A + alpha * A * x and y_C = beta_C * y_C + alpha * C * x */
+   virtual void constraint_mult(double beta_A, Vector<double>& y_A, double beta_C, Vector<double>& y_C, double alpha, const Vector<double>& x) const;
+
    void get_objective_gradient(Vector<double>& myG) const;
 
    void getbA(Vector<double>& bout) const;
@@ -1,15 +1,10 @@
 #include "StochResourcesMonitor.hpp"
-
-// save diagnostic state
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsuggest-override"
-
-#include "mpi.h"
-// turn the warnings back on
-#pragma GCC diagnostic pop
+#include "pipsdef.h"
 
 #include <fstream>
 #include <sstream>
+#include <iomanip>
+#include <iostream>
 
 #define MAX(a, b) ((a > b) ? a : b)
 
@@ -29,6 +24,7 @@ void StochNodeResourcesMonitor::reset() {
    eReduce.clear();
    eReduceScatter.clear();
    eBcast.clear();
+   eB0Reduce.clear();
    vcSchur.clear();
    vcLsolve.clear();
 }
@@ -141,6 +137,26 @@ void NodeTimer::stop_children() {
    children_time += (MPI_Wtime() - children_start_time);
 };
 
+void OverlapTimer::clear() {
+   overlapped_time = 0.0;
+   exposed_time = 0.0;
+   n_reductions = 0;
+}
+
+void OverlapTimer::posted() {
+   posted_time = MPI_Wtime();
+   ++n_reductions;
+}
+
+void OverlapTimer::wait_start() {
+   wait_start_time = MPI_Wtime();
+   overlapped_time += wait_start_time - posted_time;
+}
+
+void OverlapTimer::wait_stop() {
+   exposed_time += MPI_Wtime() - wait_start_time;
+}
+
 //**************************************************
 //*************  ITERATE monitor *******************
 //**************************************************
@@ -151,4 +167,101 @@ void Timer::start() {
 
 void Timer::stop() {
    end_time = MPI_Wtime() - start_time;
-}
\ No newline at end of file
+}
+//**************************************************
+//*************  MEMORY monitor  *******************
+//**************************************************
+
+size_t MemoryMonitor::currentTotal() {
+   size_t total = 0;
+   for (const auto& bytes : current_bytes)
+      total += bytes.load();
+   return total;
+}
+
+static size_t readProcStatusEntry(const std::string& key) {
+   std::ifstream status("/proc/self/status");
+   std::string line;
+   while (std::getline(status, line)) {
+      if (line.compare(0, key.size(), key) == 0) {
+         std::istringstream entry(line.substr(key.size()));
+         size_t kbytes = 0;
+         entry >> kbytes;
+         return kbytes * 1024;
+      }
+   }
+   return 0;
+}
+
+size_t MemoryMonitor::residentSetSize() {
+   return readProcStatusEntry("VmRSS:");
+}
+
+size_t MemoryMonitor::residentSetPeak() {
+   return readProcStatusEntry("VmHWM:");
+}
+
+const char* MemoryMonitor::categoryName(MemoryCategory category) {
+   switch (category) {
+      case MemoryCategory::LEAF_FACTORS:
+         return "leaf factors";
+      case MemoryCategory::SCHUR_COMPLEMENT:
+         return "Schur complement + factor";
+      case MemoryCategory::SC_BUFFERS:
+         return "Schur complement buffers";
+      case MemoryCategory::SC_LEAF_CONTRIBUTIONS:
+         return "cached leaf contributions";
+      case MemoryCategory::PROBLEM_DATA:
+         return "problem data";
+      case MemoryCategory::ITERATES:
+         return "iterates/steps/residuals";
+      case MemoryCategory::POSTSOLVE:
+         return "postsolve storage";
+      default:
+         return "unknown";
+   }
+}
+
+void StochNodeResourcesMonitor::printMemoryReport(MPI_Comm comm) const {
+   constexpr double mbyte = 1024.0 * 1024.0;
+   constexpr unsigned int n_categories = MemoryMonitor::n_categories;
+   const unsigned int n_entries = n_categories + 2;
+
+   /* per category peaks + process high water mark + current rss */
+   std::vector<double> local(n_entries);
+   for (unsigned int i = 0; i < n_categories; ++i)
+      local[i] = static_cast<double>(MemoryMonitor::peak(static_cast<MemoryCategory>(i))) / mbyte;
+   local[n_categories] = static_cast<double>(MemoryMonitor::residentSetPeak()) / mbyte;
+   local[n_categories + 1] = static_cast<double>(MemoryMonitor::residentSetSize()) / mbyte;
+
+   std::vector<double> min(local), max(local), sum(local);
+   PIPS_MPIminArrayInPlace(min, comm);
+   PIPS_MPImaxArrayInPlace(max, comm);
+   PIPS_MPIsumArrayInPlace(sum, comm);
+
+   const int my_rank = PIPS_MPIgetRank(comm);
+   const int size = PIPS_MPIgetSize(comm);
+
+   /* rank holding the overall high water mark - the one that goes OOM first */
+   const double my_peak = local[n_categories];
+   const int hwm_rank = PIPS_MPIgetMax(my_peak == max[n_categories] ? my_rank : -1, comm);
+
+   if (my_rank != 0)
+      return;
+
+   auto print_line = [&](const std::string& name, unsigned int i) {
+      std::cout << "   " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1) << std::setw(12)
+                << min[i] << std::setw(12) << max[i] << std::setw(12) << sum[i] / size << "\n";
+   };
+
+   std::cout << "Memory report (MB, per rank peak over " << size << " ranks):\n";
+   std::cout << "   " << std::left << std::setw(28) << "category" << std::right << std::setw(12) << "min" << std::setw(12) << "max"
+             << std::setw(12) << "avg" << "\n";
+   for (unsigned int i = 0; i < n_categories; ++i)
+      print_line(MemoryMonitor::categoryName(static_cast<MemoryCategory>(i)), i);
+   print_line("process high water mark", n_categories);
+   print_line("process resident now", n_categories + 1);
+   std::cout << "   highest high water mark on rank " << hwm_rank << "\n";
+   std::cout.unsetf(std::ios_base::floatfield);
+   std::cout << std::setprecision(6);
+}
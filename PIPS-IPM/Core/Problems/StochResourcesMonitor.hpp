@@ -1,9 +1,19 @@
 #ifndef STOCH_RESOURCE_MON
 #define STOCH_RESOURCE_MON
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <string>
 
+// save diagnostic state
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+
+#include "mpi.h"
+// turn the warnings back on
+#pragma GCC diagnostic pop
+
 //! not thread safe
 
 enum stCommType { ctAllreduce = 0, ctReduce, ctOther };
@@ -25,6 +35,24 @@ protected:
    double local_start_time, children_start_time;
 };
 
+/** time a non-blocking reduction was in flight while other work went on and time then spent waiting for it */
+class OverlapTimer {
+public:
+   void clear();
+
+   void posted();
+   void wait_start();
+   void wait_stop();
+
+   double overlapped_time{0.0};
+   double exposed_time{0.0};
+   int n_reductions{0};
+
+protected:
+   double posted_time{0.0};
+   double wait_start_time{0.0};
+};
+
 class NodeCommEntry {
 public:
    NodeCommEntry(double time_, double size_, stCommType type_) : time(time_), size(size_), type(type_) {};
@@ -72,6 +100,8 @@ public:
    virtual void recReduceScatterTmLocal_start();
    virtual void recReduceScatterTmLocal_stop();
 
+   /** collective on comm - prints the MemoryMonitor's per category peaks as min/max/avg over all ranks on rank 0 */
+   virtual void printMemoryReport(MPI_Comm comm) const;
 
 public:
 
@@ -79,6 +109,8 @@ public:
    NodeTimer eTotal;
    NodeTimer eMult;
    NodeTimer eReduce, eReduceScatter, eBcast;
+   /* reductions of the Schur complement right hand side b0 in Lsolve */
+   OverlapTimer eB0Reduce;
    std::vector<NodeCommEntry> vcSchur, vcLsolve;
 
 private:
@@ -99,4 +131,54 @@ protected:
    double start_time;
 };
 
+enum class MemoryCategory : unsigned int {
+   LEAF_FACTORS = 0, SCHUR_COMPLEMENT, SC_BUFFERS, SC_LEAF_CONTRIBUTIONS, PROBLEM_DATA, ITERATES, POSTSOLVE, N_CATEGORIES
+};
+
+/** per rank accounting of the memory held by the big components of the solver
+ *
+ * unlike the timers above this one is thread safe - the counters are global for the whole rank and can be updated from within
+ * OpenMP regions (e.g. leaf solvers factorizing in parallel)
+ */
+class MemoryMonitor {
+public:
+   static void allocate(MemoryCategory category, size_t bytes) {
+      const auto cat = static_cast<unsigned int>(category);
+      const size_t now = current_bytes[cat].fetch_add(bytes) + bytes;
+
+      size_t old_peak = peak_bytes[cat].load();
+      while (now > old_peak && !peak_bytes[cat].compare_exchange_weak(old_peak, now)) {}
+   }
+
+   static void release(MemoryCategory category, size_t bytes) {
+      current_bytes[static_cast<unsigned int>(category)].fetch_sub(bytes);
+   }
+
+   /** an allocation of old_bytes was replaced by one of new_bytes */
+   static void resize(MemoryCategory category, size_t old_bytes, size_t new_bytes) {
+      if (new_bytes > old_bytes)
+         allocate(category, new_bytes - old_bytes);
+      else
+         release(category, old_bytes - new_bytes);
+   }
+
+   [[nodiscard]] static size_t current(MemoryCategory category) { return current_bytes[static_cast<unsigned int>(category)].load(); }
+   [[nodiscard]] static size_t peak(MemoryCategory category) { return peak_bytes[static_cast<unsigned int>(category)].load(); }
+
+   /** sum of all currently accounted bytes */
+   [[nodiscard]] static size_t currentTotal();
+
+   /** resident set size and its high water mark (VmHWM) of this process as reported by /proc - 0 if not available */
+   [[nodiscard]] static size_t residentSetSize();
+   [[nodiscard]] static size_t residentSetPeak();
+
+   static const char* categoryName(MemoryCategory category);
+
+   static constexpr unsigned int n_categories{static_cast<unsigned int>(MemoryCategory::N_CATEGORIES)};
+
+private:
+   inline static std::array<std::atomic<size_t>, n_categories> current_bytes{};
+   inline static std::array<std::atomic<size_t>, n_categories> peak_bytes{};
+};
+
 #endif
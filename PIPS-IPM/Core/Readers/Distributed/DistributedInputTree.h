@@ -15,6 +15,13 @@ extern "C" typedef int (* FVEC)(void* user_data, int id, double* vec, int len);
 
 extern "C" typedef int (* FLEN)(void* user_data, int id, int* len);
 
+/**
+ * Zero-copy variant of FMAT: instead of filling arrays allocated by the solver, the user hands out its own row-major arrays (krowM of length
+ * m + 1, jcolM and M of length nnz), which are then used in place without copying. They must stay valid until the solver is destroyed and
+ * may be modified by it (e.g. when scaling). Setting *krowM to nullptr declines and falls back to the FMAT callback.
+ */
+extern "C" typedef int (* FMATBORROW)(void* user_data, int id, int** krowM, int** jcolM, double** M);
+
 
 class DistributedInputTree {
    friend class DistributedTreeCallbacks;
@@ -40,6 +47,9 @@ public:
 
       ~DistributedInputNode();
 
+      /* optional zero-copy callbacks for the constraint matrices - a nullptr keeps copying through the respective FMAT */
+      void set_borrowed_matrices(FMATBORROW fA, FMATBORROW fB, FMATBORROW fBl, FMATBORROW fC, FMATBORROW fD, FMATBORROW fDl);
+
    protected:
 
       int id{-1};
@@ -80,6 +90,13 @@ public:
       FMAT fD{};
       FMAT fDl{};
 
+      FMATBORROW fA_borrowed{};
+      FMATBORROW fB_borrowed{};
+      FMATBORROW fBl_borrowed{};
+      FMATBORROW fC_borrowed{};
+      FMATBORROW fD_borrowed{};
+      FMATBORROW fDl_borrowed{};
+
       FVEC fc{};
       FVEC fb{};
       FVEC fbl{};
@@ -116,6 +133,10 @@ public:
 
    void add_child(std::unique_ptr<DistributedInputTree> subTree);
 
+   /* children the process rank will own once the tree is distributed over n_procs processes (see DistributedTree::assignProcesses) - lets readers
+    * fetch a process' data ahead of time; empty if there are more processes than children */
+   static std::vector<int> childrenOfProcess(int n_children, int rank, int n_procs);
+
 protected:
    std::unique_ptr<DistributedInputNode> nodeInput{};
    std::vector<std::unique_ptr<DistributedInputTree>> children;
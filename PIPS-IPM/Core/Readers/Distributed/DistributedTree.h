@@ -15,11 +15,13 @@
 #include "mpi.h"
 
 class DistributedTreeCallbacks;
+class DistributedInputTree;
 
 class DistributedProblem;
 
 class DistributedTree {
    friend DistributedTreeCallbacks;
+   friend DistributedInputTree;
 public:
    StochNodeResourcesMonitor resMon;
    static Timer iterMon;
@@ -22,6 +22,7 @@ public:
    using InputNode = DistributedInputTree::DistributedInputNode;
 
    using DATA_MAT = FMAT InputNode::*;
+   using DATA_MAT_BORROWED = FMATBORROW InputNode::*;
    using DATA_VEC = FVEC InputNode::*;
    using DATA_NNZ = FNNZ InputNode::*;
    using DATA_INT = int InputNode::*;
@@ -80,6 +81,10 @@ public:
    [[nodiscard]] std::vector<MPI_Comm> getChildComms() const;
 
    void assertTreeStructureCorrect() const;
+
+   /* as the members below for processes living on the nodes node_of_proc - lets the HierarchicalAutotuner predict the split */
+   [[nodiscard]] static unsigned int alignSubTreesWithNodes(const std::vector<int>& node_of_proc, unsigned int n_sub_trees, unsigned int n_children);
+   [[nodiscard]] static bool subTreesAlignedWithNodes(const std::vector<int>& node_of_proc, unsigned int n_sub_trees);
 protected:
    void assertTreeStructureChildren() const;
    void assertSubRoot() const;
@@ -88,16 +93,24 @@ protected:
    void assertTreeStructureIsMyNodeSubRoot() const;
    void assertTreeStructureIsMyNode() const;
 
+   /* fills a block of a constraint matrix with this node's data - copied through fmat or, if the user lends its arrays, adopted without a copy */
+   void readMatrixBlock(std::unique_ptr<GeneralMatrix>& block, int nnz, FMAT fmat, FMATBORROW fmat_borrowed) const;
+
    unsigned int getMapChildrenToNthRootSubTrees(int& take_nth_root, std::vector<unsigned int>& map_child_to_sub_tree, unsigned int n_children,
          unsigned int n_procs, const std::vector<unsigned int>& child_procs);
+   /* number of sub-trees close to n_sub_trees whose processes do not share a node with another sub-tree */
+   [[nodiscard]] unsigned int alignSubTreesWithNodes(unsigned int n_sub_trees, unsigned int n_children) const;
+   [[nodiscard]] bool subTreesAlignedWithNodes(unsigned int n_sub_trees) const;
+   /* node of each of myProcs */
+   [[nodiscard]] std::vector<int> nodesOfMyProcs() const;
 
    void initPresolvedData(const DistributedSymmetricMatrix& Q, const DistributedMatrix& A, const DistributedMatrix& C, const DistributedVector<double>& nxVec,
          const DistributedVector<double>& myVec, const DistributedVector<double>& mzVec, int mylParent, int mzlParent);
 
    [[nodiscard]] std::unique_ptr<DistributedMatrix>
-   createMatrix(TREE_SIZE my, TREE_SIZE myl, DATA_INT m_ABmat, DATA_INT n_Mat, DATA_INT nnzAmat, DATA_NNZ fnnzAmat, DATA_MAT Amat, DATA_INT nnzBmat,
-         DATA_NNZ fnnzBmat, DATA_MAT Bmat, DATA_INT m_Blmat, DATA_INT nnzBlmat, DATA_NNZ fnnzBlmat, DATA_MAT Blmat,
-         const std::string& prefix_for_print) const;
+   createMatrix(TREE_SIZE my, TREE_SIZE myl, DATA_INT m_ABmat, DATA_INT n_Mat, DATA_INT nnzAmat, DATA_NNZ fnnzAmat, DATA_MAT Amat,
+         DATA_MAT_BORROWED Amat_borrowed, DATA_INT nnzBmat, DATA_NNZ fnnzBmat, DATA_MAT Bmat, DATA_MAT_BORROWED Bmat_borrowed, DATA_INT m_Blmat,
+         DATA_INT nnzBlmat, DATA_NNZ fnnzBlmat, DATA_MAT Blmat, DATA_MAT_BORROWED Blmat_borrowed, const std::string& prefix_for_print) const;
    [[nodiscard]] std::unique_ptr<DistributedVector<double>> createVector(DATA_INT n_vec, DATA_VEC vec, DATA_INT n_linking_vec, DATA_VEC linking_vec) const;
 
    void createSubcommunicatorsAndChildren(int& take_nth_root, std::vector<unsigned int>& map_child_to_sub_tree);
@@ -0,0 +1,62 @@
+/*
+ * NodeTopology.h
+ *
+ *  Node placement of the processes of a communicator and reductions that first reduce on each node and only then
+ *  between the nodes.
+ *
+ *  The split of a communicator into nodes is computed once and cached on the communicator as an MPI attribute, so it is
+ *  released together with the communicator. Nodes are detected with MPI_Comm_split_type(MPI_COMM_TYPE_SHARED) - for
+ *  testing with oversubscribed local ranks setSimulatedRanksPerNode (option MPI_SIMULATED_RANKS_PER_NODE) instead groups
+ *  that many consecutive ranks of MPI_COMM_WORLD into a node.
+ */
+
+#ifndef PIPS_IPM_CORE_UTILITIES_NODETOPOLOGY_H_
+#define PIPS_IPM_CORE_UTILITIES_NODETOPOLOGY_H_
+
+#include <vector>
+
+// save diagnostic state
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+
+#include "mpi.h"
+// turn the warnings back on
+#pragma GCC diagnostic pop
+
+struct NodeSplit {
+   /* processes of the communicator on this node - the lowest rank is the node leader */
+   MPI_Comm node_comm{MPI_COMM_NULL};
+   /* node leaders - MPI_COMM_NULL on all other processes; rank 0 of the communicator is rank 0 here */
+   MPI_Comm leader_comm{MPI_COMM_NULL};
+   int n_nodes{1};
+   /* node of each rank of the communicator, numbered in order of the node leaders */
+   std::vector<int> node_of_rank;
+
+   [[nodiscard]] bool isLeader() const { return leader_comm != MPI_COMM_NULL; };
+   /* a two stage reduction only pays off if there is more than one node and some node holds more than one process */
+   [[nodiscard]] bool twoStage() const { return n_nodes > 1 && n_nodes < static_cast<int>(node_of_rank.size()); };
+};
+
+namespace NodeTopology {
+   /* off by default - the reductions below then are plain MPI collectives */
+   void setTwoStageReductions(bool two_stage);
+
+   /* <= 0 detects the actual nodes - only affects communicators not split before */
+   void setSimulatedRanksPerNode(int ranks_per_node);
+
+   const NodeSplit& split(MPI_Comm comm);
+
+   /* true on all processes of comm iff each of its nodes holds at least two of them - collective over comm */
+   bool everyNodeShared(MPI_Comm comm);
+
+   /* like MPI_Allreduce with MPI_SUM - send == recv reduces in place */
+   void allreduceSum(const double* send, double* recv, int length, MPI_Comm comm);
+
+   /* like allreduceSum, but only the node leaders receive the sum - recv is only accessed on node leaders; always node aware */
+   void allreduceSumToNodeLeaders(const double* send, double* recv, int length, MPI_Comm comm);
+
+   /* like MPI_Reduce with MPI_SUM to rank 0 - recv is only accessed on rank 0 */
+   void reduceSumToRoot(const double* send, double* recv, int length, MPI_Comm comm);
+}
+
+#endif /* PIPS_IPM_CORE_UTILITIES_NODETOPOLOGY_H_ */
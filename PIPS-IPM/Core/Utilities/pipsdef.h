@@ -651,6 +651,23 @@ inline void PIPS_MPIsumArrayInPlace(std::vector<T>& elements, MPI_Comm mpiComm =
    MPI_Allreduce(MPI_IN_PLACE, &elements[0], elements.size(), get_mpi_datatype(&elements[0]), MPI_SUM, mpiComm);
 }
 
+/* non-blocking version of PIPS_MPIsumArrayInPlace - elements must not be touched before PIPS_MPIwait(request) returned */
+template<typename T>
+inline void PIPS_MPIisumArrayInPlace(T* elements, int length, MPI_Request& request, MPI_Comm mpiComm = MPI_COMM_WORLD) {
+   assert(length >= 0);
+
+   if (length == 0) {
+      request = MPI_REQUEST_NULL;
+      return;
+   }
+
+   MPI_Iallreduce(MPI_IN_PLACE, elements, length, get_mpi_datatype(elements), MPI_SUM, mpiComm, &request);
+}
+
+inline void PIPS_MPIwait(MPI_Request& request) {
+   MPI_Wait(&request, MPI_STATUS_IGNORE);
+}
+
 template<typename T>
 inline void PIPS_MPIsumArray(const T* source, T* dest, int length, MPI_Comm mpiComm = MPI_COMM_WORLD) {
    assert(length >= 0);
@@ -0,0 +1,152 @@
+#include "../../Core/Interface/PIPSIPMppInterface.hpp"
+#include "../../Core/Options/PIPSIPMppOptions.h"
+#include "DistributedInputTree.h"
+#include "problem_generator.hpp"
+
+#include "mpi.h"
+
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+static void printUsage(const char* name) {
+   std::cout << "Usage: " << name << " [options]\n"
+             << "  --scenarios N          number of scenarios (default 10)\n"
+             << "  --first-stage-vars N   first stage variables (default 10)\n"
+             << "  --first-stage-eq N     first stage equalities (default 5)\n"
+             << "  --first-stage-ineq N   first stage inequalities (default 5)\n"
+             << "  --block-vars N         variables per scenario (default 100)\n"
+             << "  --block-eq N           equalities per scenario (default 50)\n"
+             << "  --block-ineq N         inequalities per scenario (default 25)\n"
+             << "  --density D            fraction of non-zeros per row of each block (default 0.05)\n"
+             << "  --linking-eq N         linking equalities (default 0)\n"
+             << "  --linking-ineq N       linking inequalities (default 0)\n"
+             << "  --two-links            linking rows couple two consecutive scenarios only\n"
+             << "  --quadratic            add a positive diagonal Hessian\n"
+             << "  --seed N               seed of the generator (default 1)\n"
+             << "  --hierarchical         use the hierarchical approach\n"
+             << "  --presolve             presolve the generated problem\n";
+}
+
+static bool parseArguments(int argc, char** argv, generator_parameters& parameters, bool& hierarchical, bool& presolve) {
+   for (int i = 1; i < argc; ++i) {
+      const char* arg = argv[i];
+
+      if (strcmp(arg, "--two-links") == 0)
+         parameters.two_links = true;
+      else if (strcmp(arg, "--quadratic") == 0)
+         parameters.quadratic = true;
+      else if (strcmp(arg, "--hierarchical") == 0)
+         hierarchical = true;
+      else if (strcmp(arg, "--presolve") == 0)
+         presolve = true;
+      else {
+         if (i + 1 >= argc)
+            return false;
+         const std::string value{argv[++i]};
+
+         try {
+            if (strcmp(arg, "--scenarios") == 0)
+               parameters.n_scenarios = std::stoi(value);
+            else if (strcmp(arg, "--first-stage-vars") == 0)
+               parameters.n_first_stage_vars = std::stoi(value);
+            else if (strcmp(arg, "--first-stage-eq") == 0)
+               parameters.n_first_stage_eq = std::stoi(value);
+            else if (strcmp(arg, "--first-stage-ineq") == 0)
+               parameters.n_first_stage_ineq = std::stoi(value);
+            else if (strcmp(arg, "--block-vars") == 0)
+               parameters.n_block_vars = std::stoi(value);
+            else if (strcmp(arg, "--block-eq") == 0)
+               parameters.n_block_eq = std::stoi(value);
+            else if (strcmp(arg, "--block-ineq") == 0)
+               parameters.n_block_ineq = std::stoi(value);
+            else if (strcmp(arg, "--density") == 0)
+               parameters.density = std::stod(value);
+            else if (strcmp(arg, "--linking-eq") == 0)
+               parameters.n_linking_eq = std::stoi(value);
+            else if (strcmp(arg, "--linking-ineq") == 0)
+               parameters.n_linking_ineq = std::stoi(value);
+            else if (strcmp(arg, "--seed") == 0)
+               parameters.seed = std::stoull(value);
+            else
+               return false;
+         }
+         catch (const std::exception&) {
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+int main(int argc, char** argv) {
+
+   MPI_Init(&argc, &argv);
+   const int my_rank = PIPS_MPIgetRank();
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   const double t0 = MPI_Wtime();
+
+   generator_parameters parameters;
+   bool hierarchical = false;
+   bool presolve = false;
+
+   if (!parseArguments(argc, argv, parameters, hierarchical, presolve)) {
+      if (my_rank == 0)
+         printUsage(argv[0]);
+      MPI_Finalize();
+      return 1;
+   }
+
+   std::unique_ptr<problem_generator> generator;
+   try {
+      generator = std::make_unique<problem_generator>(parameters);
+   }
+   catch (const std::invalid_argument& e) {
+      if (my_rank == 0) {
+         std::cout << e.what() << "\n";
+         printUsage(argv[0]);
+      }
+      MPI_Finalize();
+      return 1;
+   }
+
+   generator->print_dimensions();
+   std::unique_ptr<DistributedInputTree> root{generator->generate_problem()};
+
+   if (my_rank == 0)
+      std::cout << "Using a total of " << PIPS_MPIgetSize() << " MPI processes.\n";
+
+   if (hierarchical) {
+      if (my_rank == 0)
+         std::cout << "Using Hierarchical approach\n";
+      pipsipmpp_options::activate_hierarchial_approach();
+   }
+
+   PIPSIPMppInterface pipsIpm(root.get(), InteriorPointMethodType::PRIMAL, MPI_COMM_WORLD, ScalerType::GEOMETRIC_MEAN,
+         presolve ? PresolverType::PRESOLVE : PresolverType::NONE);
+
+   if (my_rank == 0)
+      std::cout << "solving...\n";
+
+   const TerminationStatus status = pipsIpm.run();
+   const double objective = pipsIpm.getObjective();
+
+   const double t1 = MPI_Wtime();
+
+   if (my_rank == 0) {
+      if (status != TerminationStatus::SUCCESSFUL_TERMINATION)
+         std::cout << "Failed to solve Instance successfully.\n";
+      else
+         std::cout << "Solving finished.\n";
+
+      std::cout << "---Objective value: " << objective << "\n";
+      std::cout << "---Iterations: " << pipsIpm.n_iterations() << "\n";
+      std::cout << "---total time (in sec.): " << t1 - t0 << "\n";
+   }
+
+   MPI_Finalize();
+
+   return 0;
+}
@@ -0,0 +1,360 @@
+/*
+ * problem_generator.cpp
+ */
+
+#include "problem_generator.hpp"
+#include "pipsdef.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+   constexpr double x_upp = 10.0;
+   constexpr unsigned int objective_stream = 16;
+
+   std::uint64_t splitmix64(std::uint64_t x) {
+      x += 0x9e3779b97f4a7c15ULL;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+   }
+
+   const problem_generator& generator(void* user_data) {
+      return *static_cast<const problem_generator*>(user_data);
+   }
+}
+
+extern "C" {
+
+static int fsizen(void* user_data, int id, int* n) {
+   *n = generator(user_data).n_vars(id);
+   return 0;
+}
+
+static int fsizemy(void* user_data, int id, int* my) {
+   *my = generator(user_data).n_eq(id);
+   return 0;
+}
+
+static int fsizemz(void* user_data, int id, int* mz) {
+   *mz = generator(user_data).n_ineq(id);
+   return 0;
+}
+
+static int fsizemyl(void* user_data, int, int* myl) {
+   *myl = generator(user_data).n_linking_eq();
+   return 0;
+}
+
+static int fsizemzl(void* user_data, int, int* mzl) {
+   *mzl = generator(user_data).n_linking_ineq();
+   return 0;
+}
+
+#define GENERATOR_BLOCK_CALLBACKS(name, block) \
+static int fnonzero##name(void* user_data, int id, int* nnz) { \
+   *nnz = generator(user_data).n_nonzeros(problem_generator::block_type::block, id); \
+   return 0; \
+} \
+static int fmat##name(void* user_data, int id, int* krowM, int* jcolM, double* M) { \
+   generator(user_data).fill_matrix(problem_generator::block_type::block, id, krowM, jcolM, M); \
+   return 0; \
+}
+
+GENERATOR_BLOCK_CALLBACKS(Q, Q)
+GENERATOR_BLOCK_CALLBACKS(A, A)
+GENERATOR_BLOCK_CALLBACKS(B, B)
+GENERATOR_BLOCK_CALLBACKS(C, C)
+GENERATOR_BLOCK_CALLBACKS(D, D)
+GENERATOR_BLOCK_CALLBACKS(BL, BL)
+GENERATOR_BLOCK_CALLBACKS(DL, DL)
+
+#undef GENERATOR_BLOCK_CALLBACKS
+
+static int fvecc(void* user_data, int id, double* vec, int len) {
+   generator(user_data).fill_objective(id, vec, len);
+   return 0;
+}
+
+static int fvecb(void* user_data, int id, double* vec, int len) {
+   generator(user_data).fill_equality_rhs(id, vec, len);
+   return 0;
+}
+
+static int fvecclow(void* user_data, int id, double* vec, int len) {
+   generator(user_data).fill_inequality_bound(id, vec, len, false);
+   return 0;
+}
+
+static int fveccupp(void* user_data, int id, double* vec, int len) {
+   generator(user_data).fill_inequality_bound(id, vec, len, true);
+   return 0;
+}
+
+static int fvecbL(void* user_data, int, double* vec, int len) {
+   generator(user_data).fill_linking_equality_rhs(vec, len);
+   return 0;
+}
+
+static int fvecdlow(void* user_data, int, double* vec, int len) {
+   generator(user_data).fill_linking_inequality_bound(vec, len, false);
+   return 0;
+}
+
+static int fvecdupp(void* user_data, int, double* vec, int len) {
+   generator(user_data).fill_linking_inequality_bound(vec, len, true);
+   return 0;
+}
+
+static int fveczero(void*, int, double* vec, int len) {
+   std::fill(vec, vec + len, 0.0);
+   return 0;
+}
+
+static int fvecone(void*, int, double* vec, int len) {
+   std::fill(vec, vec + len, 1.0);
+   return 0;
+}
+
+static int fvecxupp(void*, int, double* vec, int len) {
+   std::fill(vec, vec + len, x_upp);
+   return 0;
+}
+
+}
+
+problem_generator::problem_generator(generator_parameters parameters_) : parameters{parameters_} {
+   const generator_parameters& p = parameters;
+   if (p.n_scenarios < 1)
+      throw std::invalid_argument("problem_generator: need at least one scenario");
+   if (p.n_first_stage_vars < 0 || p.n_first_stage_eq < 0 || p.n_first_stage_ineq < 0 || p.n_block_vars < 0 || p.n_block_eq < 0 || p.n_block_ineq < 0 ||
+      p.n_linking_eq < 0 || p.n_linking_ineq < 0)
+      throw std::invalid_argument("problem_generator: dimensions must be non-negative");
+   if (!(p.density > 0.0 && p.density <= 1.0))
+      throw std::invalid_argument("problem_generator: density must lie in (0,1]");
+   if (p.n_first_stage_eq > p.n_first_stage_vars || p.n_block_eq > p.n_block_vars)
+      throw std::invalid_argument("problem_generator: more equality rows than variables in a block");
+}
+
+std::unique_ptr<DistributedInputTree> problem_generator::generate_problem() {
+   const auto node = [this](int id) {
+      return std::make_unique<DistributedInputTree::DistributedInputNode>(this, id, &fsizen, &fsizemy, &fsizemyl, &fsizemz, &fsizemzl, &fmatQ, &fnonzeroQ,
+         &fvecc, &fmatA, &fnonzeroA, &fmatB, &fnonzeroB, &fmatBL, &fnonzeroBL, &fvecb, &fvecbL, &fmatC, &fnonzeroC, &fmatD, &fnonzeroD, &fmatDL,
+         &fnonzeroDL, &fvecclow, &fvecone, &fveccupp, &fvecone, &fvecdlow, &fvecone, &fvecdupp, &fvecone, &fveczero, &fvecone, &fvecxupp,
+         &fvecone, nullptr, false);
+   };
+
+   std::unique_ptr<DistributedInputTree> root = std::make_unique<DistributedInputTree>(node(0));
+   for (int id = 1; id <= parameters.n_scenarios; ++id)
+      root->add_child(std::make_unique<DistributedInputTree>(node(id)));
+
+   return root;
+}
+
+void problem_generator::print_dimensions() const {
+   if (PIPS_MPIgetRank() != 0)
+      return;
+
+   const generator_parameters& p = parameters;
+   const long long n_scen = p.n_scenarios;
+
+   const long long n_vars_total = p.n_first_stage_vars + n_scen * p.n_block_vars;
+   const long long n_eq_total = p.n_first_stage_eq + n_scen * p.n_block_eq + p.n_linking_eq;
+   const long long n_ineq_total = p.n_first_stage_ineq + n_scen * p.n_block_ineq + p.n_linking_ineq;
+
+   long long nnz_total = n_nonzeros(block_type::A, 0) + n_nonzeros(block_type::C, 0) + n_nonzeros(block_type::BL, 0) + n_nonzeros(block_type::DL, 0);
+   for (int id = 1; id <= p.n_scenarios; ++id)
+      for (const block_type block : {block_type::A, block_type::B, block_type::C, block_type::D, block_type::BL, block_type::DL})
+         nnz_total += n_nonzeros(block, id);
+
+   std::cout << "Generated " << (p.quadratic ? "QP" : "LP") << " with " << p.n_scenarios << " scenarios (seed " << p.seed << ")\n";
+   std::cout << "   variables: " << n_vars_total << "   equalities: " << n_eq_total << "   inequalities: " << n_ineq_total << "   non-zeros: " << nnz_total
+      << "\n";
+   std::cout << "   linking equalities: " << p.n_linking_eq << "   linking inequalities: " << p.n_linking_ineq << (uses_two_links() ? " (2-links)" : "")
+      << "\n";
+}
+
+int problem_generator::n_vars(int id) const {
+   return id == 0 ? parameters.n_first_stage_vars : parameters.n_block_vars;
+}
+
+int problem_generator::n_eq(int id) const {
+   return id == 0 ? parameters.n_first_stage_eq : parameters.n_block_eq;
+}
+
+int problem_generator::n_ineq(int id) const {
+   return id == 0 ? parameters.n_first_stage_ineq : parameters.n_block_ineq;
+}
+
+bool problem_generator::uses_two_links() const {
+   return parameters.two_links && parameters.n_scenarios >= 2;
+}
+
+int problem_generator::n_rows(block_type block, int id) const {
+   switch (block) {
+      case block_type::Q:
+         return n_vars(id);
+      case block_type::A:
+      case block_type::B:
+         return n_eq(id);
+      case block_type::C:
+      case block_type::D:
+         return n_ineq(id);
+      case block_type::BL:
+         return parameters.n_linking_eq;
+      case block_type::DL:
+         return parameters.n_linking_ineq;
+   }
+   return 0;
+}
+
+int problem_generator::n_cols(block_type block, int id) const {
+   /* A and C couple to the first stage, for the root they are the first stage blocks */
+   if (block == block_type::A || block == block_type::C)
+      return parameters.n_first_stage_vars;
+   return n_vars(id);
+}
+
+int problem_generator::nnz_per_row(int n_cols) const {
+   if (n_cols == 0)
+      return 0;
+   const auto nnz = static_cast<int>(std::lround(parameters.density * n_cols));
+   return std::min(std::max(nnz, 1), n_cols);
+}
+
+bool problem_generator::has_row(block_type block, int id, int row) const {
+   switch (block) {
+      case block_type::Q:
+         return parameters.quadratic;
+      case block_type::A:
+      case block_type::C:
+         return true;
+      case block_type::B:
+      case block_type::D:
+         /* the root's blocks are given by A and C */
+         return id != 0;
+      case block_type::BL:
+      case block_type::DL:
+         if (!uses_two_links())
+            return true;
+         else if (id == 0)
+            return false;
+         else {
+            /* row couples scenarios pair and pair + 1 (zero based) */
+            const int pair = row % (parameters.n_scenarios - 1);
+            return pair == id - 1 || pair + 1 == id - 1;
+         }
+   }
+   return false;
+}
+
+double problem_generator::linking_row_sum() const {
+   if (uses_two_links())
+      return 2.0 * nnz_per_row(parameters.n_block_vars);
+   return nnz_per_row(parameters.n_first_stage_vars) + static_cast<double>(parameters.n_scenarios) * nnz_per_row(parameters.n_block_vars);
+}
+
+std::mt19937_64 problem_generator::random_stream(unsigned int stream, int id) const {
+   const std::uint64_t key = (static_cast<std::uint64_t>(id) << 8) | stream;
+   return std::mt19937_64(splitmix64(splitmix64(parameters.seed) ^ key));
+}
+
+int problem_generator::n_nonzeros(block_type block, int id) const {
+   if (block == block_type::Q)
+      return parameters.quadratic ? n_vars(id) : 0;
+
+   const int nnz_row = nnz_per_row(n_cols(block, id));
+   int nnz = 0;
+   for (int row = 0; row < n_rows(block, id); ++row)
+      if (has_row(block, id, row))
+         nnz += nnz_row;
+   return nnz;
+}
+
+void problem_generator::fill_matrix(block_type block, int id, int* krowM, int* jcolM, double* M) const {
+   const int m = n_rows(block, id);
+   const int n = n_cols(block, id);
+   std::mt19937_64 stream = random_stream(static_cast<unsigned int>(block), id);
+
+   if (block == block_type::Q) {
+      std::uniform_real_distribution<double> diagonal(0.1, 1.0);
+      krowM[0] = 0;
+      for (int row = 0; row < m; ++row) {
+         const int nnz = krowM[row];
+         if (has_row(block, id, row)) {
+            jcolM[nnz] = row;
+            M[nnz] = diagonal(stream);
+         }
+         krowM[row + 1] = nnz + (has_row(block, id, row) ? 1 : 0);
+      }
+      return;
+   }
+
+   const int nnz_row = nnz_per_row(n);
+   std::vector<char> taken(nnz_row > 0 ? n : 0, 0);
+   std::uniform_real_distribution<double> shift(1.5, 2.5);
+   std::bernoulli_distribution negative;
+
+   krowM[0] = 0;
+   for (int row = 0; row < m; ++row) {
+      const int start = krowM[row];
+      if (nnz_row == 0 || !has_row(block, id, row)) {
+         krowM[row + 1] = start;
+         continue;
+      }
+
+      /* Floyd's sampling of nnz_row distinct columns */
+      int* const cols = jcolM + start;
+      for (int j = n - nnz_row, pos = 0; j < n; ++j, ++pos) {
+         const int t = std::uniform_int_distribution<int>(0, j)(stream);
+         const int col = taken[t] ? j : t;
+         taken[col] = 1;
+         cols[pos] = col;
+      }
+      std::sort(cols, cols + nnz_row);
+      for (int pos = 0; pos < nnz_row; ++pos)
+         taken[cols[pos]] = 0;
+
+      /* entries come in pairs 1 + s, 1 - s with |s| in [1.5, 2.5] so that they are bounded away from zero, have mixed signs and every row sums
+       * up to nnz_row */
+      double* const vals = M + start;
+      for (int pos = 0; pos + 1 < nnz_row; pos += 2) {
+         const double s = negative(stream) ? -shift(stream) : shift(stream);
+         vals[pos] = 1.0 + s;
+         vals[pos + 1] = 1.0 - s;
+      }
+      if (nnz_row % 2 == 1)
+         vals[nnz_row - 1] = 1.0;
+
+      krowM[row + 1] = start + nnz_row;
+   }
+}
+
+void problem_generator::fill_objective(int id, double* c, int len) const {
+   std::mt19937_64 stream = random_stream(objective_stream, id);
+   std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+   for (int i = 0; i < len; ++i)
+      c[i] = distribution(stream);
+}
+
+void problem_generator::fill_equality_rhs(int id, double* b, int len) const {
+   /* row sums at x = 1 */
+   const double rhs = nnz_per_row(parameters.n_first_stage_vars) + (id == 0 ? 0.0 : nnz_per_row(parameters.n_block_vars));
+   std::fill(b, b + len, rhs);
+}
+
+void problem_generator::fill_inequality_bound(int id, double* bound, int len, bool upper) const {
+   const double activity = nnz_per_row(parameters.n_first_stage_vars) + (id == 0 ? 0.0 : nnz_per_row(parameters.n_block_vars));
+   std::fill(bound, bound + len, upper ? activity + 1.0 : activity - 1.0);
+}
+
+void problem_generator::fill_linking_equality_rhs(double* bl, int len) const {
+   std::fill(bl, bl + len, linking_row_sum());
+}
+
+void problem_generator::fill_linking_inequality_bound(double* bound, int len, bool upper) const {
+   std::fill(bound, bound + len, upper ? linking_row_sum() + 1.0 : linking_row_sum() - 1.0);
+}
@@ -0,0 +1,93 @@
+/*
+ * problem_generator.hpp
+ *
+ * Synthetic two-stage block-angular LPs/QPs of arbitrary size, passed to PIPS-IPM++ through the DistributedInputTree callbacks.
+ */
+
+#ifndef PIPS_IPM_DRIVERS_GENERATOR_PROBLEMGENERATOR_HPP_
+#define PIPS_IPM_DRIVERS_GENERATOR_PROBLEMGENERATOR_HPP_
+
+#include "DistributedInputTree.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+struct generator_parameters {
+   int n_scenarios{10};
+
+   int n_first_stage_vars{10};
+   int n_first_stage_eq{5};
+   int n_first_stage_ineq{5};
+
+   int n_block_vars{100};
+   int n_block_eq{50};
+   int n_block_ineq{25};
+
+   /* fraction of non-zeros per row in every generated block (at least one entry per non-empty row) */
+   double density{0.05};
+
+   int n_linking_eq{0};
+   int n_linking_ineq{0};
+   /* linking constraints only couple two consecutive scenarios (2-links) instead of the first stage and all scenarios */
+   bool two_links{false};
+
+   /* add a positive diagonal Hessian */
+   bool quadratic{false};
+
+   std::uint64_t seed{1};
+};
+
+/**
+ * Generates
+ *
+ *    min  sum_i c_i^T x_i (+ 1/2 x_i^T Q_i x_i)
+ *    s.t. A_0 x_0                 = b_0,       clow_0 <= C_0 x_0                 <= cupp_0
+ *         A_i x_0 + B_i x_i       = b_i,       clow_i <= C_i x_0 + D_i x_i       <= cupp_i     i = 1..N
+ *         sum_i Bl_i x_i          = bl,        dllow  <= sum_i Dl_i x_i          <= dlupp
+ *         0 <= x_i <= 10
+ *
+ * Every block is generated on demand from its own random stream seeded by (seed, node, block), so a rank only generates the blocks it owns
+ * and the problem does not depend on the number of ranks. All rows of a block hold the same number of entries and sum up to it; this makes
+ * x = 1 strictly feasible and gives all right hand sides (also of the linking rows) in closed form without generating the other blocks.
+ */
+class problem_generator {
+public:
+   enum class block_type { Q, A, B, C, D, BL, DL };
+
+   explicit problem_generator(generator_parameters parameters);
+
+   std::unique_ptr<DistributedInputTree> generate_problem();
+
+   void print_dimensions() const;
+
+   /* callback interface - id 0 is the first stage, id i the i-th scenario */
+   [[nodiscard]] int n_vars(int id) const;
+   [[nodiscard]] int n_eq(int id) const;
+   [[nodiscard]] int n_ineq(int id) const;
+   [[nodiscard]] int n_linking_eq() const { return parameters.n_linking_eq; };
+   [[nodiscard]] int n_linking_ineq() const { return parameters.n_linking_ineq; };
+
+   [[nodiscard]] int n_nonzeros(block_type block, int id) const;
+   void fill_matrix(block_type block, int id, int* krowM, int* jcolM, double* M) const;
+
+   void fill_objective(int id, double* c, int len) const;
+   void fill_equality_rhs(int id, double* b, int len) const;
+   void fill_inequality_bound(int id, double* bound, int len, bool upper) const;
+   void fill_linking_equality_rhs(double* bl, int len) const;
+   void fill_linking_inequality_bound(double* bound, int len, bool upper) const;
+
+private:
+   const generator_parameters parameters;
+
+   [[nodiscard]] bool uses_two_links() const;
+   [[nodiscard]] int n_rows(block_type block, int id) const;
+   [[nodiscard]] int n_cols(block_type block, int id) const;
+   [[nodiscard]] int nnz_per_row(int n_cols) const;
+   [[nodiscard]] bool has_row(block_type block, int id, int row) const;
+   [[nodiscard]] double linking_row_sum() const;
+
+   [[nodiscard]] std::mt19937_64 random_stream(unsigned int stream, int id) const;
+};
+
+#endif /* PIPS_IPM_DRIVERS_GENERATOR_PROBLEMGENERATOR_HPP_ */
@@ -9,7 +9,8 @@
 #include <cstring>
 #include <iostream>
 
-static void setParams(ScalerType& scaler_type, bool& stepDiffLp, bool& presolve, bool& printsol, bool& hierarchical, const char* paramname) {
+static void setParams(ScalerType& scaler_type, bool& stepDiffLp, bool& presolve, bool& printsol, bool& printsolblocks, bool& hierarchical,
+      const char* paramname) {
    if (strcmp(paramname, "scale") == 0 || strcmp(paramname, "scaleEqui") == 0)
       scaler_type = ScalerType::EQUILIBRIUM;
    else if (strcmp(paramname, "scaleGeo") == 0)
@@ -24,6 +25,8 @@ static void setParams(ScalerType& scaler_type, bool& stepDiffLp, bool& presolve,
       presolve = true;
    else if (strcmp(paramname, "printsol") == 0)
       printsol = true;
+   else if (strcmp(paramname, "printsolblocks") == 0)
+      printsolblocks = true;
    else if (strcmp(paramname, "hierarchical") == 0)
       hierarchical = true;
 }
@@ -40,10 +43,11 @@ int main(int argc, char** argv) {
    bool primal_dual_step_length = false;
    bool presolve = false;
    bool printsol = false;
+   bool printsolblocks = false;
    bool hierarchical = false;
 
-   if ((argc < 3) || (argc > 9)) {
-      std::cout << "Usage: " << argv[0] << " numBlocks file_name[.gdx] GDXLibDir [scale] [stepLp] [presolve] [printsol] [hierarchical_approach]\n";
+   if ((argc < 3) || (argc > 10)) {
+      std::cout << "Usage: " << argv[0] << " numBlocks file_name[.gdx] GDXLibDir [scale] [stepLp] [presolve] [printsol] [printsolblocks] [hierarchical_approach]\n";
       std::cout << "Expecting files to be of the form \"file_nameXX\", where XX specifies a block from 0 to num_blocks!\n";
       exit(1);
    }
@@ -53,7 +57,7 @@ int main(int argc, char** argv) {
    const std::string path_to_gams{argv[3]};
 
    for (int i = 5; i <= argc; ++i) {
-      setParams(scaler_type, primal_dual_step_length, presolve, printsol, hierarchical, argv[i - 1]);
+      setParams(scaler_type, primal_dual_step_length, presolve, printsol, printsolblocks, hierarchical, argv[i - 1]);
    }
 
    if (my_rank == 0) {
@@ -118,6 +122,13 @@ int main(int argc, char** argv) {
       reader.write_solution(pipsIpm, file_name);
    }
 
+   /* binary scenario blocks written by all processes in parallel - no gather to rank 0 */
+   if (printsolblocks) {
+      pipsIpm.writeSolutionBlocks(file_name);
+      if (my_rank == 0)
+         std::cout << "Solution blocks written to " << file_name << "_*.bin\n";
+   }
+
    MPI_Barrier(MPI_COMM_WORLD);
    const double tn = MPI_Wtime();
 
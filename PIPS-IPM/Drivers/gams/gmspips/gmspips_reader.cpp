@@ -10,7 +10,12 @@
 #include "../../../Core/Interface/PIPSIPMppInterface.hpp"
 #include "../../../Core/InteriorPointMethod/TerminationStatus.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <omp.h>
 
 const size_t MAX_PATH_LENGHT = 256;
 
@@ -29,23 +34,44 @@ static char fileName[MAX_PATH_LENGHT];
 static char GDXDirectory[MAX_PATH_LENGHT];
 static int numBlocks = 0; // TODO make size_t?
 FILE* fLog;
+/* result of the read of each block started by gmspips_reader::prefetch_blocks - invalid for blocks read lazily */
+static std::vector<std::shared_future<int>> prefetchedBlocks;
+/* the gdxCreate and gdxFree of blocks read concurrently must not overlap - handed to readBlock via setGDXCreateFreeLock */
+static std::mutex gdxCreateFreeMutex;
+static void lockGDXCreateFree() { gdxCreateFreeMutex.lock(); }
+static void unlockGDXCreateFree() { gdxCreateFreeMutex.unlock(); }
+
+static int readGMSBlock(GMSPIPSBlockData_t** blocks, int blk) {
+   int rc;
+   fprintf(fLog, "Block %d read on gms_rank %d\n", blk, gms_rank);
+   blocks[blk] = (GMSPIPSBlockData_t*) malloc(sizeof(GMSPIPSBlockData_t));
+   if (!allGDX) {
+      char fname[MAX_PATH_LENGHT];
+      int r = snprintf(fname, MAX_PATH_LENGHT, "%s%d.gdx", fileName, blk);
+      if (r < 0)
+         abort();
+      rc = readBlock(numBlocks, blk, 0, 1, fname, &GDXDirectory[0], blocks[blk]);
+   }
+   else
+      rc = readBlock(numBlocks, blk, 0, 1, fileName, &GDXDirectory[0], blocks[blk]);
+   if (rc)
+      fprintf(fLog, "Block %d read on gms_rank %d failed rc=%d\n", blk, gms_rank, rc);
+   return rc;
+}
+
+/* blocks handed to the reader threads are waited for, all others are read on first access */
+static int getGMSBlock(GMSPIPSBlockData_t** blocks, int blk) {
+   if (blk < static_cast<int>(prefetchedBlocks.size()) && prefetchedBlocks[blk].valid())
+      return prefetchedBlocks[blk].get();
+   if (blocks[blk])
+      return 0;
+   return readGMSBlock(blocks, blk);
+}
 
 #define checkAndAlloc(blk)                                                        \
-   if (!blocks[blk])                                                                 \
    {                                                                                 \
-      int rc;                                                                        \
-      fprintf(fLog,"Block %d read on gms_rank %d\n", blk, gms_rank);                   \
-      blocks[blk] = (GMSPIPSBlockData_t*) malloc(sizeof(GMSPIPSBlockData_t));        \
-      if ( !allGDX )                                                                 \
-      {                                                                              \
-         char fname[MAX_PATH_LENGHT];                                                \
-         int r = snprintf(fname, MAX_PATH_LENGHT, "%s%d.gdx", fileName, blk);        \
-         if( r < 0 )  abort();                                                       \
-         rc = readBlock(numBlocks,blk,0,1,fname,&GDXDirectory[0],blocks[blk]);       \
-      }                                                                              \
-      else                                                                           \
-         rc = readBlock(numBlocks,blk,0,1,fileName,&GDXDirectory[0],blocks[blk]);    \
-      if (rc) {fprintf(fLog,"Block %d read on gms_rank %d failed rc=%d\n", blk, gms_rank, rc); return rc;} \
+      int rc = getGMSBlock(blocks, blk);                                             \
+      if (rc) return rc;                                                             \
    }
 
 #define nCB(nType)                                                   \
@@ -156,6 +182,29 @@ matCB(D, C)
 matCB(BL, BL)
 matCB(DL, DL)
 
+/* lends the block's arrays to PIPS instead of copying them - the blocks live as long as the reader */
+#define matBorrowCB(mat, mmat)                                                          \
+   int fmatBorrow##mat(void* user_data, int id, int** krowM, int** jcolM, double** M)   \
+   {                                                                                   \
+      GMSPIPSBlockData_t** blocks = (GMSPIPSBlockData_t**) user_data;                  \
+      checkAndAlloc(id);                                                               \
+      GMSPIPSBlockData_t* blk = blocks[id];                                            \
+      assert(blk);                                                                     \
+      fprintf(fLog,"matBorrowCB blk=%d " #mat " mLen %d nzLen %ld\n",id,blk->m##mmat,blk->nnz##mat); \
+      /* empty blocks come without row starts - those are copied */                    \
+      *krowM = ( 0==blk->m##mmat ) ? nullptr : blk->rm##mat;                            \
+      *jcolM = blk->ci##mat;                                                           \
+      *M = blk->val##mat;                                                              \
+      return 0;                                                                        \
+   }
+
+matBorrowCB(A, A)
+matBorrowCB(B, A)
+matBorrowCB(C, C)
+matBorrowCB(D, C)
+matBorrowCB(BL, BL)
+matBorrowCB(DL, DL)
+
 int fnonzeroQ(void*, int, int* nnz) {
    *nnz = 0;
    return 0;
@@ -176,6 +225,7 @@ int fmatQ(void* user_data, int id, int* krowM, int*, double*) {
 gmspips_reader::gmspips_reader(std::string path_to_problem_, std::string path_to_gams_, size_t n_blocks_) :
    pips_reader(std::move(path_to_problem_), n_blocks_), path_to_gams{std::move(path_to_gams_)} {
    initGMSPIPSIO();
+   setGDXCreateFreeLock(lockGDXCreateFree, unlockGDXCreateFree);
 
    blocks.resize(n_blocks);
 
@@ -200,6 +250,10 @@ gmspips_reader::gmspips_reader(std::string path_to_problem_, std::string path_to
 }
 
 gmspips_reader::~gmspips_reader() {
+   for (auto& reader : block_readers)
+      reader.join();
+   prefetchedBlocks.clear();
+
    for (auto& block : blocks) {
       freeBlock(block);
       free(block);
@@ -208,7 +262,42 @@ gmspips_reader::~gmspips_reader() {
    fclose(fLog);
 }
 
+void gmspips_reader::prefetch_blocks() {
+   if (!prefetchedBlocks.empty())
+      return;
+   prefetchedBlocks.resize(n_blocks);
+
+   /* the root block is needed everywhere - it is read before any of the readers starts */
+   std::promise<int> root_read;
+   root_read.set_value(readGMSBlock(blocks.data(), 0));
+   prefetchedBlocks[0] = root_read.get_future().share();
+
+   /* a block not prefetched here is still read on first access */
+   auto own_blocks = std::make_shared<std::vector<int>>(DistributedInputTree::childrenOfProcess(numBlocks - 1, my_rank, PIPS_MPIgetSize()));
+   for (int& block : *own_blocks)
+      ++block;
+
+   const size_t n_readers = std::min(own_blocks->size(), static_cast<size_t>(std::max(1, n_reader_threads > 0 ? n_reader_threads : omp_get_max_threads())));
+   if (n_readers == 0)
+      return;
+
+   auto reads = std::make_shared<std::vector<std::promise<int>>>(own_blocks->size());
+   for (size_t i = 0; i < own_blocks->size(); ++i)
+      prefetchedBlocks[(*own_blocks)[i]] = (*reads)[i].get_future().share();
+
+   /* the readers take the blocks in the order the tree will ask for them - the tree construction only waits for blocks not read yet */
+   auto next_block = std::make_shared<std::atomic<size_t>>(0);
+   for (size_t reader = 0; reader < n_readers; ++reader) {
+      block_readers.emplace_back([this, own_blocks, reads, next_block]() {
+         for (size_t i = (*next_block)++; i < own_blocks->size(); i = (*next_block)++)
+            (*reads)[i].set_value(readGMSBlock(blocks.data(), (*own_blocks)[i]));
+      });
+   }
+}
+
 std::unique_ptr<DistributedInputTree> gmspips_reader::read_problem() {
+   prefetch_blocks();
+
    FNNZ fsni = &fsizeni;
    FNNZ fsmA = &fsizemA;
    FNNZ fsmC = &fsizemC;
@@ -246,14 +335,23 @@ std::unique_ptr<DistributedInputTree> gmspips_reader::read_problem() {
    FMAT fDL = &fmatDL;
    FMAT fQ = &fmatQ;
 
+   FMATBORROW fA_borrowed = &fmatBorrowA;
+   FMATBORROW fB_borrowed = &fmatBorrowB;
+   FMATBORROW fC_borrowed = &fmatBorrowC;
+   FMATBORROW fD_borrowed = &fmatBorrowD;
+   FMATBORROW fBL_borrowed = &fmatBorrowBL;
+   FMATBORROW fDL_borrowed = &fmatBorrowDL;
+
    //build the problem tree
    std::unique_ptr<DistributedInputTree::DistributedInputNode> data_root = std::make_unique<DistributedInputTree::DistributedInputNode>(blocks.data(), 0, fsni, fsmA, fsmBL, fsmC, fsmDL, fQ, fnnzQ, fc, fA, fnnzA, fB, fnnzB, fBL, fnnzBL, fb, fbL,
          fC, fnnzC, fD, fnnzD, fDL, fnnzDL, fclow, ficlow, fcupp, ficupp, fdlow, fidlow, fdupp, fidupp, fxlow, fixlow, fxupp, fixupp, fixtyp, false);
+   data_root->set_borrowed_matrices(fA_borrowed, fB_borrowed, fBL_borrowed, fC_borrowed, fD_borrowed, fDL_borrowed);
    std::unique_ptr<DistributedInputTree> root = std::make_unique<DistributedInputTree>(std::move(data_root));
 
    for (int blk = 1; blk < numBlocks; blk++) {
       std::unique_ptr<DistributedInputTree::DistributedInputNode> data = std::make_unique<DistributedInputTree::DistributedInputNode>(blocks.data(), blk, fsni, fsmA, fsmBL, fsmC, fsmDL, fQ, fnnzQ, fc, fA, fnnzA, fB, fnnzB, fBL, fnnzBL, fb,
             fbL, fC, fnnzC, fD, fnnzD, fDL, fnnzDL, fclow, ficlow, fcupp, ficupp, fdlow, fidlow, fdupp, fidupp, fxlow, fixlow, fxupp, fixupp, fixtyp, false);
+      data->set_borrowed_matrices(fA_borrowed, fB_borrowed, fBL_borrowed, fC_borrowed, fD_borrowed, fDL_borrowed);
 
       root->add_child(std::make_unique<DistributedInputTree>(std::move(data)));
    }
@@ -10,6 +10,9 @@
 
 #include <string>
 #include <cassert>
+#include <future>
+#include <thread>
+#include <vector>
 
 #include "../../pips_reader.h"
 #include "gmspipsio.h"
@@ -23,10 +26,18 @@ public:
    std::unique_ptr<DistributedInputTree> read_problem() override;
    void write_solution(PIPSIPMppInterface& solver_instance, const std::string& file_name) const override;
 
+   /* number of threads reading this process' blocks in the background - <= 0 uses omp_get_max_threads() */
+   void set_reader_threads(int n_threads) { n_reader_threads = n_threads; };
+
 protected:
+   /* reads the root block and starts reading all children assigned to this process concurrently */
+   void prefetch_blocks();
+
    std::vector<GMSPIPSBlockData_t*> blocks;
    const std::string path_to_gams;
    bool log_reading{false};
+   int n_reader_threads{0};
+   std::vector<std::thread> block_readers;
 };
 
 #endif /* PIPS_IPM_DRIVERS_GMSPIPS_GMSPIPSREADER_HPP_ */
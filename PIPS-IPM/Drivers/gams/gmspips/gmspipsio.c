@@ -1354,6 +1354,16 @@ int gdxSplitting(const int numBlocks,        /** < total number of blocks n in p
 }
 
 
+/* readBlock may run concurrently for different blocks - gdxCreate (which loads the GDX library) and gdxFree may not */
+static void (*gdxCreateFreeLock)(void) = NULL;
+static void (*gdxCreateFreeUnlock)(void) = NULL;
+
+void setGDXCreateFreeLock(void (*lock)(void), void (*unlock)(void))
+{
+   gdxCreateFreeLock = lock;
+   gdxCreateFreeUnlock = unlock;
+}
+
 int readBlock(const int numBlocks,       /** < total number of blocks n in problem 0..n */
               const int actBlock,        /** < number of block to read 0..n */
               const int debugMode,       /** < indicator for clean blocks */
@@ -1392,12 +1402,16 @@ int readBlock(const int numBlocks,       /** < total number of blocks n in probl
    assert(actBlock>=0 && actBlock<numBlocks);
    assert(gdxFilename);
 
+   if ( gdxCreateFreeLock )
+      gdxCreateFreeLock();
 #if !defined(GDXSOURCE)
    if ( GAMSSysDir )
       rc = gdxCreateD (&fGDX, GAMSSysDir, msg, sizeof(msg));
    else
 #endif
       rc = gdxCreate (&fGDX, msg, sizeof(msg));
+   if ( gdxCreateFreeUnlock )
+      gdxCreateFreeUnlock();
 
    if ( !rc )
    {
@@ -2010,7 +2024,11 @@ if (blk->rm##mat)
 
    skipMatrix: 
    gdxClose(fGDX);
+   if ( gdxCreateFreeLock )
+      gdxCreateFreeLock();
    gdxFree(&fGDX);
+   if ( gdxCreateFreeUnlock )
+      gdxCreateFreeUnlock();
    free(varPerm);
    free(equTypeNr);
    free(vemap);
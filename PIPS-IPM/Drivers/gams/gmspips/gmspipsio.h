@@ -94,6 +94,8 @@ int gdxSplitting(const int numBlocks,        /** < total number of blocks n in p
               const char* gdxFilename,       /** < GDX file name with CONVERTD jacobian structure */
               const char* GAMSSysDir);       /** < GAMS system directory to locate shared libraries (can be NULL) */
 void freeBlock(GMSPIPSBlockData_t* blk);
+void setGDXCreateFreeLock(void (*lock)(void),      /** < called before each gdxCreate/gdxFree in readBlock (can be NULL) */
+                          void (*unlock)(void));   /** < called after each gdxCreate/gdxFree in readBlock (can be NULL) */
 #if defined(__cplusplus)
 }
 #endif
@@ -50,6 +50,19 @@ TEST_P(GmspipsReaderTest, TestReadGamsSmallProblems) {
    DistributedFactory factory(tree.get(), MPI_COMM_WORLD);
 };
 
+/* more reader threads than blocks - all of them create and free their GDX objects at the same time */
+TEST_P(GmspipsReaderTest, TestReadGamsSmallProblemsConcurrently) {
+   const std::string& problem_paths(std::get<0>(GetParam()));
+   const size_t& n_blocks_per_problem(std::get<1>(GetParam()));
+
+   gmspips_reader reader(problem_paths, gams_path, n_blocks_per_problem);
+   reader.set_reader_threads(static_cast<int>(2 * n_blocks_per_problem));
+
+   std::unique_ptr<DistributedInputTree> tree(reader.read_problem());
+   ASSERT_TRUE(tree);
+   DistributedFactory factory(tree.get(), MPI_COMM_WORLD);
+};
+
 INSTANTIATE_TEST_CASE_P
 (TestReadGamsSmallProblems, GmspipsReaderTest,
       ::testing::Values(std::make_tuple(GmspipsReaderTest::examples_path + "examples_boundTightening/run_exampleAC_boundStrength/exampleAC_boundStrength", 3),
@@ -183,4 +183,100 @@ TEST_P(ScenarioTests, TestGamssmallScaleGeoPresolve) {
    solveInstanceAndCheckResult(result, n_expected_iterations, root + problem_paths, n_blocks, PresolverType::PRESOLVE, ScalerType::GEOMETRIC_MEAN, InteriorPointMethodType::PRIMAL);
 };
 
+TEST_P(ScenarioTests, TestGamssmallUpdateProblemDataAndResolve) {
+   const std::string& problem_paths(GetParam().name);
+   const size_t n_blocks(GetParam().n_blocks);
+   const double expected_objective(GetParam().result);
+
+   if (static_cast<size_t>(world_size) >= n_blocks)
+      GTEST_SKIP();
+
+   if (!verbose)
+      testing::internal::CaptureStdout();
+
+   gmspips_reader reader(root + problem_paths, gams_path, n_blocks);
+   std::unique_ptr<DistributedInputTree> tree(reader.read_problem());
+
+   PIPSIPMppInterface pipsIpm(tree.get(), InteriorPointMethodType::PRIMAL_DUAL, MPI_COMM_WORLD, ScalerType::GEOMETRIC_MEAN, PresolverType::NONE);
+
+   const TerminationStatus first_result = pipsIpm.run();
+   const double first_objective = pipsIpm.getObjective();
+   const int first_iterations = pipsIpm.n_iterations();
+
+   /* re-reading the unchanged data keeps the structure - the second solve starts from the first solution; gmspips lends its
+    * matrices, which were scaled in place, and the default options permute the linking structure - neither may pile up over
+    * repeated updates */
+   EXPECT_NO_THROW(pipsIpm.update_problem_data());
+   EXPECT_NO_THROW(pipsIpm.update_problem_data());
+   EXPECT_EQ(pipsIpm.termination_status(), TerminationStatus::DID_NOT_RUN);
+
+   const TerminationStatus second_result = pipsIpm.run();
+   const double second_objective = pipsIpm.getObjective();
+   const int second_iterations = pipsIpm.n_iterations();
+
+   std::string output;
+   if (!verbose)
+      output = testing::internal::GetCapturedStdout();
+
+   EXPECT_EQ(first_result, TerminationStatus::SUCCESSFUL_TERMINATION);
+   EXPECT_EQ(second_result, TerminationStatus::SUCCESSFUL_TERMINATION);
+   EXPECT_NEAR(expected_objective, first_objective, solution_tol) << " while solving " << problem_paths << "\nOutput_run: " << output << "\n";
+   EXPECT_NEAR(first_objective, second_objective, solution_tol) << " while re-solving " << problem_paths << "\nOutput_run: " << output << "\n";
+   EXPECT_LE(second_iterations, first_iterations);
+}
+
+TEST_P(ScenarioTests, TestGamssmallUpdateProblemDataRejectsPresolve) {
+   const std::string& problem_paths(GetParam().name);
+   const size_t n_blocks(GetParam().n_blocks);
+
+   if (static_cast<size_t>(world_size) >= n_blocks)
+      GTEST_SKIP();
+
+   if (!verbose)
+      testing::internal::CaptureStdout();
+
+   gmspips_reader reader(root + problem_paths, gams_path, n_blocks);
+   std::unique_ptr<DistributedInputTree> tree(reader.read_problem());
+
+   PIPSIPMppInterface pipsIpm(tree.get(), InteriorPointMethodType::PRIMAL_DUAL, MPI_COMM_WORLD, ScalerType::NONE, PresolverType::PRESOLVE);
+   EXPECT_THROW(pipsIpm.update_problem_data(), std::logic_error);
+
+   if (!verbose)
+      testing::internal::GetCapturedStdout();
+}
+
+TEST_P(ScenarioTests, TestGamssmallIpoptRegularizationWarmStartIterations) {
+   const std::string& problem_paths(GetParam().name);
+   const size_t n_blocks(GetParam().n_blocks);
+   const double expected_objective(GetParam().result);
+
+   if (static_cast<size_t>(world_size) >= n_blocks)
+      GTEST_SKIP();
+
+   const bool regularization_before = pipsipmpp_options::get_bool_parameter("REGULARIZATION");
+   const int strategy_before = pipsipmpp_options::get_int_parameter("REGULARIZATION_STRATEGY");
+   const bool warm_start_before = pipsipmpp_options::get_bool_parameter("IPOPT_REGULARIZATION_WARM_START");
+   pipsipmpp_options::set_bool_parameter("REGULARIZATION", true);
+   pipsipmpp_options::set_int_parameter("REGULARIZATION_STRATEGY", 0);
+
+   pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", false);
+   const auto[cold_result, cold_objective, cold_iterations, cold_output] = solveInstance(root + problem_paths, n_blocks, PresolverType::NONE,
+      ScalerType::GEOMETRIC_MEAN, InteriorPointMethodType::PRIMAL_DUAL);
+
+   pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", true);
+   const auto[warm_result, warm_objective, warm_iterations, warm_output] = solveInstance(root + problem_paths, n_blocks, PresolverType::NONE,
+      ScalerType::GEOMETRIC_MEAN, InteriorPointMethodType::PRIMAL_DUAL);
+
+   pipsipmpp_options::set_bool_parameter("REGULARIZATION", regularization_before);
+   pipsipmpp_options::set_int_parameter("REGULARIZATION_STRATEGY", strategy_before);
+   pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", warm_start_before);
+
+   EXPECT_EQ(cold_result, TerminationStatus::SUCCESSFUL_TERMINATION);
+   EXPECT_EQ(warm_result, TerminationStatus::SUCCESSFUL_TERMINATION);
+   EXPECT_NEAR(expected_objective, cold_objective, solution_tol) << " while solving " << problem_paths << "\nOutput_run: " << cold_output << "\n";
+   EXPECT_NEAR(expected_objective, warm_objective, solution_tol) << " while solving " << problem_paths << "\nOutput_run: " << warm_output << "\n";
+   /* skipping the unregularized factorization must not cost interior point iterations */
+   EXPECT_LE(warm_iterations, cold_iterations) << " warm starting the regularization took more iterations on " << problem_paths << "\n";
+}
+
 INSTANTIATE_TEST_SUITE_P(InstantiateTestsWithAllGamssmallInstances, ScenarioTests, ::testing::ValuesIn(getInstances()));
@@ -0,0 +1,232 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "DistributedTreeCallbacks.h"
+#include "DistributedMatrix.h"
+#include "SparseMatrix.h"
+#include "PIPSIPMppOptions.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/* matrices read through FMATBORROW reference the user's CSR arrays - the solver must neither copy nor free them, and everything it
+ * allocates when it restructures such a matrix later on belongs to the solver */
+class BorrowedMatricesTest : public ::testing::Test {
+protected:
+   struct CSR {
+      std::vector<int> krowM;
+      std::vector<int> jcolM;
+      std::vector<double> M;
+
+      [[nodiscard]] int nnz() const { return static_cast<int>(jcolM.size()); }
+   };
+
+   /* root: 3 variables, 2 equalities; children: 2 variables, 2 equalities each, no inequalities and no linking constraints */
+   struct UserData {
+      CSR A0{{0, 2, 3}, {0, 2, 1}, {1.0, 2.0, 3.0}};
+      CSR A[2]{{{0, 1, 2}, {0, 2}, {10.0, 20.0}}, {{0, 1, 2}, {1, 2}, {11.0, 21.0}}};
+      CSR B[2]{{{0, 2, 3}, {0, 1, 1}, {30.0, 31.0, 40.0}}, {{0, 1, 3}, {1, 0, 1}, {32.0, 41.0, 42.0}}};
+
+      /* matrices lent - all others are copied */
+      bool lend_A[2]{true, false};
+      bool lend_B[2]{true, true};
+
+      [[nodiscard]] CSR& a(int id) { return id == -1 ? A0 : A[id]; }
+   };
+
+   static int fn(void*, int id, int* n) {
+      *n = id == -1 ? 3 : 2;
+      return 0;
+   }
+
+   static int fmy(void*, int, int* my) {
+      *my = 2;
+      return 0;
+   }
+
+   static int fmz(void*, int, int* mz) {
+      *mz = 0;
+      return 0;
+   }
+
+   static int fnnzA(void* user_data, int id, int* nnz) {
+      *nnz = static_cast<UserData*>(user_data)->a(id).nnz();
+      return 0;
+   }
+
+   static int fnnzB(void* user_data, int id, int* nnz) {
+      *nnz = static_cast<UserData*>(user_data)->B[id].nnz();
+      return 0;
+   }
+
+   static void copy(const CSR& csr, int* krowM, int* jcolM, double* M) {
+      std::memcpy(krowM, csr.krowM.data(), csr.krowM.size() * sizeof(int));
+      std::memcpy(jcolM, csr.jcolM.data(), csr.jcolM.size() * sizeof(int));
+      std::memcpy(M, csr.M.data(), csr.M.size() * sizeof(double));
+   }
+
+   static void lend(CSR& csr, int** krowM, int** jcolM, double** M) {
+      *krowM = csr.krowM.data();
+      *jcolM = csr.jcolM.data();
+      *M = csr.M.data();
+   }
+
+   static int fA(void* user_data, int id, int* krowM, int* jcolM, double* M) {
+      copy(static_cast<UserData*>(user_data)->a(id), krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fB(void* user_data, int id, int* krowM, int* jcolM, double* M) {
+      copy(static_cast<UserData*>(user_data)->B[id], krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fA_borrowed(void* user_data, int id, int** krowM, int** jcolM, double** M) {
+      auto& data = *static_cast<UserData*>(user_data);
+      if (id == -1 || data.lend_A[id])
+         lend(data.a(id), krowM, jcolM, M);
+      else
+         *krowM = nullptr;
+      return 0;
+   }
+
+   static int fB_borrowed(void* user_data, int id, int** krowM, int** jcolM, double** M) {
+      auto& data = *static_cast<UserData*>(user_data);
+      if (data.lend_B[id])
+         lend(data.B[id], krowM, jcolM, M);
+      else
+         *krowM = nullptr;
+      return 0;
+   }
+
+   static std::unique_ptr<DistributedInputTree::DistributedInputNode> node(UserData& data, int id) {
+      auto input_node = std::make_unique<DistributedInputTree::DistributedInputNode>(&data, id, fn, fmy, nullptr, fmz, nullptr, nullptr, nullptr,
+            nullptr, fA, fnnzA, id == -1 ? nullptr : fB, id == -1 ? nullptr : fnnzB, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+            nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+            nullptr);
+      input_node->set_borrowed_matrices(fA_borrowed, id == -1 ? nullptr : fB_borrowed, nullptr, nullptr, nullptr, nullptr);
+      return input_node;
+   }
+
+   static void SetUpTestSuite() {
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+   }
+
+   void SetUp() override {
+      if (PIPS_MPIgetSize() > 2)
+         GTEST_SKIP() << "the tree has only two children";
+   }
+
+   std::unique_ptr<DistributedMatrix> createA(UserData& data) {
+      input_tree = std::make_unique<DistributedInputTree>(node(data, -1));
+      for (int child = 0; child < 2; ++child)
+         input_tree->add_child(node(data, child));
+
+      tree = std::make_unique<DistributedTreeCallbacks>(input_tree.get());
+      tree->assignProcesses();
+      tree->computeGlobalSizes();
+      return tree->createA();
+   }
+
+   static void expectEntries(const SparseStorage& storage, const CSR& csr) {
+      ASSERT_EQ(storage.len, csr.nnz());
+      EXPECT_THAT(std::vector<int>(storage.krowM, storage.krowM + storage.m + 1), ::testing::ElementsAreArray(csr.krowM));
+      EXPECT_THAT(std::vector<int>(storage.jcolM, storage.jcolM + storage.len), ::testing::ElementsAreArray(csr.jcolM));
+      EXPECT_THAT(std::vector<double>(storage.M, storage.M + storage.len), ::testing::ElementsAreArray(csr.M));
+   }
+
+   static const SparseStorage& storage(const GeneralMatrix& mat) {
+      return dynamic_cast<const SparseMatrix&>(mat).getStorage();
+   }
+
+   std::unique_ptr<DistributedInputTree> input_tree;
+   std::unique_ptr<DistributedTreeCallbacks> tree;
+};
+
+TEST_F(BorrowedMatricesTest, LentArraysAreUsedInPlace) {
+   UserData data;
+   const UserData original;
+   std::unique_ptr<DistributedMatrix> A = createA(data);
+
+   /* A_0 sits in the root's B block */
+   EXPECT_EQ(storage(*A->Bmat).krowM, data.A0.krowM.data());
+   EXPECT_EQ(storage(*A->Bmat).jcolM, data.A0.jcolM.data());
+   EXPECT_EQ(storage(*A->Bmat).M, data.A0.M.data());
+   expectEntries(storage(*A->Bmat), original.A0);
+
+   ASSERT_EQ(A->children.size(), 2u);
+   for (int child = 0; child < 2; ++child) {
+      if (A->children[child]->is_a(kStochGenDummyMatrix))
+         continue;
+      const DistributedMatrix& A_child = *A->children[child];
+
+      EXPECT_EQ(storage(*A_child.Amat).M == data.A[child].M.data(), data.lend_A[child]) << " child " << child;
+      EXPECT_EQ(storage(*A_child.Bmat).M == data.B[child].M.data(), data.lend_B[child]) << " child " << child;
+
+      /* lent or copied - the entries are the same */
+      expectEntries(storage(*A_child.Amat), original.A[child]);
+      expectEntries(storage(*A_child.Bmat), original.B[child]);
+   }
+
+   /* the user's arrays outlive the matrix untouched - a delete[] on them would fail when the vectors are destroyed */
+   A.reset();
+   expectEntries(SparseStorage(2, 3, data.A0.nnz(), data.A0.krowM.data(), data.A0.jcolM.data(), data.A0.M.data()), original.A0);
+}
+
+TEST_F(BorrowedMatricesTest, DeclinedMatricesAreCopied) {
+   UserData data;
+   data.lend_A[0] = data.lend_B[0] = data.lend_B[1] = false;
+   const UserData original;
+
+   std::unique_ptr<DistributedMatrix> A = createA(data);
+   for (int child = 0; child < 2; ++child) {
+      if (A->children[child]->is_a(kStochGenDummyMatrix))
+         continue;
+      EXPECT_NE(storage(*A->children[child]->Amat).M, data.A[child].M.data());
+      EXPECT_NE(storage(*A->children[child]->Bmat).M, data.B[child].M.data());
+      expectEntries(storage(*A->children[child]->Amat), original.A[child]);
+      expectEntries(storage(*A->children[child]->Bmat), original.B[child]);
+   }
+}
+
+/* permuteRows and shaveLeft build new arrays - they replace the lent ones without freeing them and are owned by the storage */
+TEST_F(BorrowedMatricesTest, RestructuringLeavesLentArraysAlone) {
+   UserData data;
+   const UserData original;
+   CSR& lent = data.B[1];
+
+   {
+      SparseStorage permuted(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data());
+      permuted.permuteRows({1, 0});
+
+      EXPECT_NE(permuted.M, lent.M.data());
+      expectEntries(permuted, CSR{{0, 2, 3}, {0, 1, 1}, {41.0, 42.0, 32.0}});
+   }
+   expectEntries(SparseStorage(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data()), original.B[1]);
+
+   {
+      SparseStorage shaved(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data());
+      std::unique_ptr<SparseStorage> border = shaved.shaveLeft(1);
+
+      EXPECT_NE(shaved.M, lent.M.data());
+      expectEntries(*border, CSR{{0, 0, 1}, {0}, {41.0}});
+      expectEntries(shaved, CSR{{0, 1, 2}, {0, 0}, {32.0, 42.0}});
+
+      /* a second restructuring frees the arrays the first one allocated */
+      shaved.permuteRows({1, 0});
+      expectEntries(shaved, CSR{{0, 1, 2}, {0, 0}, {42.0, 32.0}});
+   }
+   expectEntries(SparseStorage(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data()), original.B[1]);
+
+   /* permuteCols renumbers and re-sorts the rows in place - it has to do so on a copy */
+   {
+      SparseStorage permuted(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data());
+      permuted.permuteCols({1, 0});
+
+      EXPECT_NE(permuted.M, lent.M.data());
+      EXPECT_NE(permuted.jcolM, lent.jcolM.data());
+      expectEntries(permuted, CSR{{0, 1, 3}, {0, 0, 1}, {32.0, 42.0, 41.0}});
+   }
+   expectEntries(SparseStorage(2, 2, lent.nnz(), lent.krowM.data(), lent.jcolM.data(), lent.M.data()), original.B[1]);
+}
@@ -0,0 +1,130 @@
+#include "gtest/gtest.h"
+
+#include "HierarchicalAutotuner.hpp"
+#include "DistributedTreeCallbacks.h"
+#include "PIPSIPMppOptions.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/* the autotuner's model without a problem and without calibration - processes are placed on the nodes node_of_proc */
+class AutotunerModel : public HierarchicalAutotuner {
+public:
+   explicit AutotunerModel(std::vector<int> node_of_proc, int n_blocks = 12) : HierarchicalAutotuner(std::move(node_of_proc)) {
+      two_links_per_block.assign(n_blocks, 10.0);
+      leaf_sizes.assign(n_blocks, 1000.0);
+      leaf_factor_density = 25.0;
+
+      n_global_links = 50;
+      n_a0_rows = 10;
+      n_sparse_link_vars = 5;
+      max_sc_nnz = std::numeric_limits<double>::infinity();
+
+      calibration.dense_rate = 1e10;
+      calibration.sparse_rate = 1e9;
+      calibration.reduce_latency = 1e-5;
+      calibration.reduce_time_per_double = 1e-9;
+   }
+
+   using HierarchicalAutotuner::Configuration;
+   using HierarchicalAutotuner::cheapest;
+   using HierarchicalAutotuner::n_sparse_link_vars;
+   using HierarchicalAutotuner::nSubRoots;
+   using HierarchicalAutotuner::price;
+   using HierarchicalAutotuner::priceCandidates;
+};
+
+/* the model has to predict the split splitTree will actually do - including the alignment of the sub-roots with the nodes */
+class HierarchicalAutotunerTest : public ::testing::Test {
+protected:
+   static void SetUpTestSuite() {
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+   }
+
+   void SetUp() override {
+      pipsipmpp_options::set_bool_parameter("HIERARCHICAL_APPLY_SPLIT", true);
+      pipsipmpp_options::set_int_parameter("HIERARCHICAL_AUTOTUNE_BUFFER_MB", 1024);
+   }
+};
+
+TEST_F(HierarchicalAutotunerTest, SubRootsFollowTheNodeAlignment) {
+   /* 12 blocks, 3 layers: splitTree wants 2 sub-roots {0,1,2} and {3,4,5} - with two processes per node both would share the node {2,3} */
+   const std::vector<int> two_per_node{0, 0, 1, 1, 2, 2};
+   EXPECT_EQ(AutotunerModel(two_per_node).nSubRoots(12, 0, 6, 3), 3);
+   EXPECT_EQ(DistributedTreeCallbacks::alignSubTreesWithNodes(two_per_node, 2, 12), 3u);
+
+   /* already aligned */
+   EXPECT_EQ(AutotunerModel({0, 0, 0, 1, 1, 1}).nSubRoots(12, 0, 6, 3), 2);
+   EXPECT_EQ(AutotunerModel({0, 1, 2, 3, 4, 5}).nSubRoots(12, 0, 6, 3), 2);
+
+   /* a sub-tree only sees its own processes - {2,3,4,5} on the nodes {1,1,2,2} splits into two node local halves, on the nodes
+    * {0,1,1,1} the first half would reach into the node of the second - single process sub-roots instead */
+   EXPECT_EQ(AutotunerModel(two_per_node).nSubRoots(4, 2, 4, 2), 2);
+   EXPECT_EQ(AutotunerModel({0, 0, 0, 1, 1, 1}).nSubRoots(4, 2, 4, 2), 4);
+}
+
+TEST_F(HierarchicalAutotunerTest, PriceDependsOnTheNodesOnlyThroughTheSplit) {
+   const double misaligned = AutotunerModel({0, 0, 1, 1, 2, 2}).price(3, false).predicted_time;
+   const double one_per_node = AutotunerModel({0, 1, 2, 3, 4, 5}).price(3, false).predicted_time;
+   const double three_per_node = AutotunerModel({0, 0, 0, 1, 1, 1}).price(3, false).predicted_time;
+
+   EXPECT_DOUBLE_EQ(one_per_node, three_per_node);
+   EXPECT_NE(misaligned, one_per_node);
+
+   /* a single layer does not split at all */
+   EXPECT_DOUBLE_EQ(AutotunerModel({0, 0, 1, 1, 2, 2}).price(1, false).predicted_time,
+      AutotunerModel({0, 1, 2, 3, 4, 5}).price(1, false).predicted_time);
+}
+
+TEST_F(HierarchicalAutotunerTest, CheapestCandidateIsChosen) {
+   const AutotunerModel model({0, 0, 1, 1, 2, 2});
+   const std::vector<AutotunerModel::Configuration> candidates = model.priceCandidates();
+   ASSERT_FALSE(candidates.empty());
+
+   const auto& chosen = AutotunerModel::cheapest(candidates);
+   for (const auto& candidate : candidates)
+      EXPECT_LE(chosen.predicted_time, candidate.predicted_time);
+}
+
+TEST_F(HierarchicalAutotunerTest, LayersStopWhereTheTreeDoes) {
+   /* 4 blocks on one process allow 2 sub-roots for 2 layers, but none for 3 */
+   const std::vector<AutotunerModel::Configuration> candidates = AutotunerModel({0}, 4).priceCandidates();
+
+   int max_layers = 0;
+   for (const auto& candidate : candidates)
+      max_layers = std::max(max_layers, candidate.n_layers);
+   EXPECT_EQ(max_layers, 2);
+}
+
+TEST_F(HierarchicalAutotunerTest, NoSplitCandidatesWithoutApplySplit) {
+   pipsipmpp_options::set_bool_parameter("HIERARCHICAL_APPLY_SPLIT", false);
+
+   const std::vector<AutotunerModel::Configuration> candidates = AutotunerModel({0, 0, 1, 1, 2, 2}).priceCandidates();
+   ASSERT_EQ(candidates.size(), 2u);
+   for (const auto& candidate : candidates)
+      EXPECT_EQ(candidate.n_layers, 1);
+}
+
+TEST_F(HierarchicalAutotunerTest, A0MovesWithoutSparseLinkingVariables) {
+   AutotunerModel model({0, 0, 1, 1, 2, 2});
+   model.n_sparse_link_vars = 0;
+
+   for (const auto& candidate : model.priceCandidates())
+      EXPECT_TRUE(candidate.move_a0_to_dense_layer);
+}
+
+TEST_F(HierarchicalAutotunerTest, BlockwiseOnlyIfTheBuffersDoNotFit) {
+   const AutotunerModel model({0, 0, 1, 1, 2, 2});
+
+   /* 60 dense columns of 1000 doubles each fit into a GB */
+   const auto all_at_once = model.price(2, true);
+   EXPECT_FALSE(all_at_once.compute_blockwise);
+   EXPECT_EQ(all_at_once.blocksize, 60);
+
+   pipsipmpp_options::set_int_parameter("HIERARCHICAL_AUTOTUNE_BUFFER_MB", 0);
+   const auto blockwise = model.price(2, true);
+   EXPECT_TRUE(blockwise.compute_blockwise);
+   EXPECT_EQ(blockwise.blocksize, 20);
+}
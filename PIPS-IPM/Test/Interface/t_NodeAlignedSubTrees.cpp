@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "DistributedTreeCallbacks.h"
+#include "NodeTopology.h"
+#include "PIPSIPMppOptions.h"
+
+#include <numeric>
+#include <set>
+#include <vector>
+
+/* run with 6 MPI processes - MPI_SIMULATED_RANKS_PER_NODE = 2 turns them into the nodes {0,1}, {2,3} and {4,5} */
+class NodeAlignedSubTreesTest : public DistributedTreeCallbacks, public ::testing::Test {
+protected:
+   static constexpr int n_ranks = 6;
+   static constexpr int ranks_per_node = 2;
+
+   static void SetUpTestSuite() {
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+      pipsipmpp_options::set_int_parameter("MPI_SIMULATED_RANKS_PER_NODE", ranks_per_node);
+      /* as done by PIPSIPMppInterface - has to happen before MPI_COMM_WORLD is split into nodes for the first time */
+      NodeTopology::setSimulatedRanksPerNode(pipsipmpp_options::get_int_parameter("MPI_SIMULATED_RANKS_PER_NODE"));
+   }
+
+   void SetUp() override {
+      if (PIPS_MPIgetSize() != n_ranks)
+         GTEST_SKIP() << "needs " << n_ranks << " MPI processes";
+
+      commWrkrs = MPI_COMM_WORLD;
+      setProcs({0, 1, 2, 3, 4, 5});
+   }
+
+   void setProcs(const std::vector<int>& procs) {
+      myProcs = procs;
+   }
+
+   /* the nodes the processes of each sub-tree live on - sub-trees split myProcs into equal consecutive parts */
+   std::vector<std::set<int>> nodesOfSubTrees(unsigned int n_sub_trees) const {
+      const std::vector<int>& node_of_rank = NodeTopology::split(MPI_COMM_WORLD).node_of_rank;
+      std::vector<std::set<int>> nodes(n_sub_trees);
+      for (size_t proc = 0; proc < myProcs.size(); ++proc)
+         nodes[proc / (myProcs.size() / n_sub_trees)].insert(node_of_rank[myProcs[proc]]);
+      return nodes;
+   }
+};
+
+TEST_F(NodeAlignedSubTreesTest, SimulatedNodesGroupConsecutiveRanks) {
+   const NodeSplit& split = NodeTopology::split(MPI_COMM_WORLD);
+
+   EXPECT_EQ(split.n_nodes, n_ranks / ranks_per_node);
+   EXPECT_THAT(split.node_of_rank, ::testing::ElementsAre(0, 0, 1, 1, 2, 2));
+   EXPECT_EQ(split.isLeader(), PIPS_MPIgetRank() % ranks_per_node == 0);
+   EXPECT_TRUE(split.twoStage());
+}
+
+TEST_F(NodeAlignedSubTreesTest, AlignedSplitIsKept) {
+   EXPECT_EQ(alignSubTreesWithNodes(3, 12), 3);
+   EXPECT_EQ(alignSubTreesWithNodes(6, 12), 6);
+}
+
+TEST_F(NodeAlignedSubTreesTest, SplitAcrossNodesIsAdjusted) {
+   /* {0,1,2} and {3,4,5} would share the node {2,3} - one sub-tree per node instead */
+   EXPECT_FALSE(subTreesAlignedWithNodes(2));
+   const unsigned int n_sub_trees = alignSubTreesWithNodes(2, 12);
+   EXPECT_EQ(n_sub_trees, 3);
+
+   const auto nodes = nodesOfSubTrees(n_sub_trees);
+   for (unsigned int sub_tree = 0; sub_tree < n_sub_trees; ++sub_tree)
+      EXPECT_THAT(nodes[sub_tree], ::testing::ElementsAre(static_cast<int>(sub_tree)));
+}
+
+TEST_F(NodeAlignedSubTreesTest, SubsetOfProcessesOffsetToTheNodes) {
+   /* {1,2} and {3,4} both cross a node boundary and share the node {2,3} - only single process sub-trees are aligned */
+   setProcs({1, 2, 3, 4});
+   EXPECT_EQ(alignSubTreesWithNodes(2, 12), 4);
+
+   /* not enough children for that - the split stays as it is */
+   EXPECT_EQ(alignSubTreesWithNodes(2, 3), 2);
+}
+
+TEST_F(NodeAlignedSubTreesTest, ChildrenMapToNodeAlignedSubTrees) {
+   /* six children, one per process - the square root split into two sub-trees would cross the node {2,3} */
+   const unsigned int n_children = 6;
+   std::vector<unsigned int> child_procs(n_children);
+   std::iota(child_procs.begin(), child_procs.end(), 0);
+
+   int take_nth_root = 2;
+   std::vector<unsigned int> map_child_to_sub_tree;
+   const unsigned int n_sub_trees = getMapChildrenToNthRootSubTrees(take_nth_root, map_child_to_sub_tree, n_children, n_ranks, child_procs);
+
+   ASSERT_EQ(n_sub_trees, 3);
+   EXPECT_EQ(take_nth_root, 2);
+
+   /* every sub-tree gets exactly the children of the processes of one node */
+   const std::vector<int>& node_of_rank = NodeTopology::split(MPI_COMM_WORLD).node_of_rank;
+   ASSERT_EQ(map_child_to_sub_tree.size(), n_children);
+   for (unsigned int child = 0; child < n_children; ++child)
+      EXPECT_EQ(static_cast<int>(map_child_to_sub_tree[child]), node_of_rank[child_procs[child]]) << " for child " << child;
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include "IpoptRegularization.hpp"
+#include "PIPSIPMppOptions.h"
+#include "mpi.h"
+
+#include <cmath>
+
+class IpoptRegularizationTest : public ::testing::Test {
+protected:
+   static constexpr unsigned int n_positive = 5, n_negative = 3;
+   const Inertia singular{n_positive - 1, n_negative, 1};
+   const Inertia wrong{n_positive - 1, n_negative + 1, 0};
+
+   bool warm_start_before{false};
+
+   void SetUp() override {
+      warm_start_before = pipsipmpp_options::get_bool_parameter("IPOPT_REGULARIZATION_WARM_START");
+   }
+
+   void TearDown() override {
+      pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", warm_start_before);
+   }
+};
+
+TEST_F(IpoptRegularizationTest, WarmStartIsOffByDefault) {
+   EXPECT_FALSE(warm_start_before);
+
+   IpoptRegularization strategy(n_positive, n_negative, MPI_COMM_SELF);
+   strategy.notify_new_step();
+   EXPECT_EQ(strategy.get_default_regularization(1.0), Regularization(0.0, 0.0, 0.0));
+   (void) strategy.get_regularization_parameters(singular, 1.0);
+
+   /* without warm start every step starts unregularized */
+   strategy.notify_new_step();
+   EXPECT_EQ(strategy.get_default_regularization(1e-4), Regularization(0.0, 0.0, 0.0));
+}
+
+TEST_F(IpoptRegularizationTest, WarmStartRederivesTheDualTermForTheCurrentBarrierParameter) {
+   pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", true);
+   IpoptRegularization strategy(n_positive, n_negative, MPI_COMM_SELF);
+
+   strategy.notify_new_step();
+   (void) strategy.get_default_regularization(1.0);
+   const auto [primal, dual_equality, dual_inequality] = strategy.get_regularization_parameters(singular, 1.0);
+   EXPECT_GT(primal, 0.0);
+   EXPECT_DOUBLE_EQ(dual_equality, 1.0);
+   EXPECT_DOUBLE_EQ(dual_inequality, 1.0);
+
+   strategy.notify_new_step();
+   const auto [warm_primal, warm_dual_equality, warm_dual_inequality] = strategy.get_default_regularization(1e-4);
+   EXPECT_DOUBLE_EQ(warm_primal, primal / 3.0);
+   EXPECT_DOUBLE_EQ(warm_dual_equality, std::pow(1e-4, 0.25));
+   EXPECT_DOUBLE_EQ(warm_dual_inequality, std::pow(1e-4, 0.25));
+
+   /* further corrections of the warm started step never decrease the regularization */
+   const auto [next_primal, next_dual_equality, next_dual_inequality] = strategy.get_regularization_parameters(wrong, 1e-4);
+   EXPECT_GT(next_primal, warm_primal);
+   EXPECT_DOUBLE_EQ(next_dual_equality, warm_dual_equality);
+   EXPECT_DOUBLE_EQ(next_dual_inequality, warm_dual_inequality);
+
+   /* the warm started step corrected again, so the next one warm starts as well - again with the dual term of the new barrier parameter */
+   strategy.notify_new_step();
+   const auto [primal_nonsingular, dual_nonsingular, dual_inequality_nonsingular] = strategy.get_default_regularization(1e-8);
+   EXPECT_DOUBLE_EQ(primal_nonsingular, next_primal / 3.0);
+   EXPECT_DOUBLE_EQ(dual_nonsingular, std::pow(1e-8, 0.25));
+   (void) dual_inequality_nonsingular;
+}
+
+TEST_F(IpoptRegularizationTest, WarmStartStopsAfterAStepWithoutCorrection) {
+   pipsipmpp_options::set_bool_parameter("IPOPT_REGULARIZATION_WARM_START", true);
+   IpoptRegularization strategy(n_positive, n_negative, MPI_COMM_SELF);
+
+   strategy.notify_new_step();
+   (void) strategy.get_default_regularization(1.0);
+   (void) strategy.get_regularization_parameters(wrong, 1.0);
+
+   /* warm started factorization had correct inertia right away */
+   strategy.notify_new_step();
+   const auto [warm_primal, warm_dual_equality, warm_dual_inequality] = strategy.get_default_regularization(1e-2);
+   EXPECT_GT(warm_primal, 0.0);
+   EXPECT_DOUBLE_EQ(warm_dual_equality, 1e-4);
+   EXPECT_DOUBLE_EQ(warm_dual_inequality, 1e-4);
+
+   strategy.notify_new_step();
+   EXPECT_EQ(strategy.get_default_regularization(1e-4), Regularization(0.0, 0.0, 0.0));
+}
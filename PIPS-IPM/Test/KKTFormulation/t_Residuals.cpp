@@ -0,0 +1,230 @@
+#include "gtest/gtest.h"
+
+#include "Residuals.h"
+#include "Variables.h"
+#include "Problem.hpp"
+#include "DistributedVector.h"
+#include "DistributedMatrix.h"
+#include "DistributedSymmetricMatrix.h"
+#include "SparseMatrix.h"
+#include "SparseSymmetricMatrix.h"
+#include "DenseVector.hpp"
+#include "mpi.h"
+
+#include <functional>
+#include <memory>
+#include <random>
+
+/* plain Problem around distributed data - only what Residuals::evaluate needs */
+class TwoStageTestProblem : public Problem {
+public:
+   using Problem::Problem;
+
+   [[nodiscard]] std::unique_ptr<Problem> clone_full() const override { return nullptr; };
+   void write_to_streamDense(std::ostream&) const override {};
+};
+
+/* root with linking variables and linking constraints, two children */
+class ResidualsTest : public ::testing::Test {
+protected:
+   static constexpr int n_children = 2;
+   static constexpr int n0 = 2, my0 = 1, mz0 = 2, my_link = 1, mz_link = 2;
+   static constexpr int n_child = 3, my_child = 2, mz_child = 2;
+
+   /* seeded with the rank so that wrongly reducing over MPI_COMM_WORLD changes results whenever the test runs on several ranks */
+   std::mt19937 generator{static_cast<unsigned int>(4711 + PIPS_MPIgetRank())};
+   /* every rank holds its own, complete problem */
+   const MPI_Comm comm{MPI_COMM_SELF};
+
+   double random(double lower = -2.0, double upper = 2.0) { return std::uniform_real_distribution<double>(lower, upper)(generator); };
+
+   std::shared_ptr<DistributedVector<double>> columnVector() const {
+      auto vec = std::make_shared<DistributedVector<double>>(n0, comm);
+      for (int i = 0; i < n_children; ++i)
+         vec->AddChild(std::make_shared<DistributedVector<double>>(n_child, comm));
+      return vec;
+   }
+
+   std::shared_ptr<DistributedVector<double>> rowVector(int m0, int m_link, int m_child) const {
+      auto vec = std::make_shared<DistributedVector<double>>(m0, m_link, comm);
+      for (int i = 0; i < n_children; ++i)
+         vec->AddChild(std::make_shared<DistributedVector<double>>(m_child, comm));
+      return vec;
+   }
+
+   void forEachEntry(DistributedVector<double>& vec, const std::function<void(double&)>& f) {
+      for (auto* part : {vec.first.get(), vec.last.get()}) {
+         if (!part)
+            continue;
+         auto& dense = dynamic_cast<DenseVector<double>&>(*part);
+         for (int i = 0; i < dense.length(); ++i)
+            f(dense[i]);
+      }
+      for (auto& child : vec.children)
+         forEachEntry(*child, f);
+   }
+
+   std::shared_ptr<DistributedVector<double>> randomVector(const std::shared_ptr<DistributedVector<double>>& vec, double lower = -2.0, double upper = 2.0) {
+      forEachEntry(*vec, [&](double& entry) { entry = random(lower, upper); });
+      return vec;
+   }
+
+   std::shared_ptr<DistributedVector<double>> randomIndicator(const std::shared_ptr<DistributedVector<double>>& vec) {
+      forEachEntry(*vec, [&](double& entry) { entry = random(0.0, 1.0) < 0.6 ? 1.0 : 0.0; });
+      return vec;
+   }
+
+   std::unique_ptr<SparseMatrix> randomSparse(int m, int n) {
+      std::vector<double> dense(static_cast<size_t>(m) * n);
+      int nnz = 0;
+      for (double& entry : dense) {
+         entry = random(0.0, 1.0) < 0.5 ? random() : 0.0;
+         nnz += entry != 0.0;
+      }
+
+      auto mat = std::make_unique<SparseMatrix>(m, n, nnz);
+      SparseStorage& storage = mat->getStorage();
+      int pos = 0;
+      for (int row = 0; row < m; ++row) {
+         storage.krowM[row] = pos;
+         for (int col = 0; col < n; ++col) {
+            if (dense[static_cast<size_t>(row) * n + col] != 0.0) {
+               storage.jcolM[pos] = col;
+               storage.M[pos] = dense[static_cast<size_t>(row) * n + col];
+               ++pos;
+            }
+         }
+      }
+      storage.krowM[m] = pos;
+      return mat;
+   }
+
+   std::shared_ptr<DistributedMatrix> randomConstraintMatrix(int m0, int m_link, int m_child) {
+      auto mat = std::make_shared<DistributedMatrix>(std::make_unique<SparseMatrix>(m0, 0, 0), randomSparse(m0, n0), randomSparse(m_link, n0), comm);
+      for (int i = 0; i < n_children; ++i)
+         mat->AddChild(std::make_shared<DistributedMatrix>(randomSparse(m_child, n0), randomSparse(m_child, n_child), randomSparse(m_link, n_child), comm));
+      mat->recomputeSize();
+      return mat;
+   }
+
+   std::unique_ptr<DistributedSymmetricMatrix> diagonalHessian(int n_root) {
+      auto diagonal = [this](int n) {
+         auto Q = std::make_unique<DistributedSymmetricMatrix>(n, n, n, comm);
+         auto& diag = dynamic_cast<SparseSymmetricMatrix&>(*Q->diag);
+         for (int i = 0; i < n; ++i) {
+            diag.krowM()[i] = i;
+            diag.jcolM()[i] = i;
+            diag.M()[i] = random(0.1, 3.0);
+         }
+         diag.krowM()[n] = n;
+         return Q;
+      };
+      auto Q = diagonal(n_root);
+      for (int i = 0; i < n_children; ++i)
+         Q->AddChild(std::shared_ptr<DistributedSymmetricMatrix>(diagonal(n_child)));
+      Q->recomputeSize();
+      return Q;
+   }
+
+   std::unique_ptr<TwoStageTestProblem> problem;
+   std::unique_ptr<Variables> iterate;
+   std::unique_ptr<Residuals> residuals;
+
+   void SetUp() override {
+      auto ixlow = randomIndicator(columnVector());
+      auto ixupp = randomIndicator(columnVector());
+      auto iclow = randomIndicator(rowVector(mz0, mz_link, mz_child));
+      auto icupp = randomIndicator(rowVector(mz0, mz_link, mz_child));
+
+      problem = std::make_unique<TwoStageTestProblem>(randomVector(columnVector()), diagonalHessian(n0), randomVector(columnVector()), ixlow,
+         randomVector(columnVector()), ixupp, randomConstraintMatrix(my0, my_link, my_child), randomVector(rowVector(my0, my_link, my_child)),
+         randomConstraintMatrix(mz0, mz_link, mz_child), randomVector(rowVector(mz0, mz_link, mz_child)), iclow,
+         randomVector(rowVector(mz0, mz_link, mz_child)), icupp);
+
+      auto unique_copy = [](const std::shared_ptr<DistributedVector<double>>& vec) {
+         return std::unique_ptr<Vector<double>>(vec->clone_full());
+      };
+      auto column = [&](double lower, double upper) { return unique_copy(randomVector(columnVector(), lower, upper)); };
+      auto row_y = [&]() { return unique_copy(randomVector(rowVector(my0, my_link, my_child))); };
+      auto row_z = [&](double lower, double upper) { return unique_copy(randomVector(rowVector(mz0, mz_link, mz_child), lower, upper)); };
+
+      iterate = std::make_unique<Variables>(column(-2.0, 2.0), row_z(-2.0, 2.0), row_y(), row_z(-2.0, 2.0), column(0.1, 1.0), column(0.1, 1.0),
+         column(0.1, 1.0), column(0.1, 1.0), row_z(0.1, 1.0), row_z(0.1, 1.0), row_z(0.1, 1.0), row_z(0.1, 1.0), ixlow, ixupp, iclow, icupp);
+
+      residuals = std::make_unique<Residuals>(unique_copy(columnVector()), unique_copy(rowVector(my0, my_link, my_child)),
+         unique_copy(rowVector(mz0, mz_link, mz_child)), unique_copy(rowVector(mz0, mz_link, mz_child)), unique_copy(rowVector(mz0, mz_link, mz_child)),
+         unique_copy(rowVector(mz0, mz_link, mz_child)), unique_copy(rowVector(mz0, mz_link, mz_child)), unique_copy(rowVector(mz0, mz_link, mz_child)),
+         unique_copy(columnVector()), unique_copy(columnVector()), unique_copy(columnVector()), unique_copy(columnVector()), ixlow, ixupp, iclow,
+         icupp);
+   }
+};
+
+TEST_F(ResidualsTest, PrimalObjectiveMatchesDirectEvaluation) {
+   residuals->evaluate(*problem, *iterate);
+
+   /* 1/2 x^T Q x + g^T x */
+   std::unique_ptr<Vector<double>> Qx{iterate->primals->clone()};
+   problem->hessian_multiplication(0.0, *Qx, 1.0, *iterate->primals);
+   const double objective = problem->objective_gradient->dotProductWith(*iterate->primals) + 0.5 * Qx->dotProductWith(*iterate->primals);
+
+   EXPECT_NEAR(residuals->get_primal_objective(), objective, 1e-10 * (1.0 + std::fabs(objective)));
+}
+
+TEST_F(ResidualsTest, ReductionsStayOnTheProblemCommunicator) {
+   residuals->evaluate(*problem, *iterate);
+
+   double residual_norm = 0.0;
+   for (const Vector<double>* vec : {residuals->lagrangian_gradient.get(), residuals->equality_residuals.get(), residuals->inequality_residuals.get(),
+      residuals->inequality_dual_residuals.get(), residuals->rt.get(), residuals->ru.get(), residuals->rv.get(), residuals->rw.get()})
+      residual_norm = std::max(residual_norm, vec->inf_norm());
+
+   EXPECT_DOUBLE_EQ(residuals->compute_residual_norm(), residual_norm);
+   EXPECT_DOUBLE_EQ(residuals->get_residual_norm(), residual_norm);
+
+   const double violation = residuals->equality_residuals->one_norm() + residuals->inequality_residuals->one_norm();
+   EXPECT_NEAR(residuals->constraint_violation(), violation, 1e-12 * (1.0 + violation));
+}
+
+/* the line search updates residuals and complementarity along a step instead of evaluating them at each trial point */
+TEST_F(ResidualsTest, StepChangeMatchesEvaluationAtTheTrialPoint) {
+   std::unique_ptr<Variables> step = iterate->clone_full();
+   for (Vector<double>* vec : {step->primals.get(), step->slacks.get(), step->equality_duals.get(), step->inequality_duals.get(),
+      step->primal_lower_bound_gap.get(), step->primal_lower_bound_gap_dual.get(), step->primal_upper_bound_gap.get(),
+      step->primal_upper_bound_gap_dual.get(), step->slack_lower_bound_gap.get(), step->slack_lower_bound_gap_dual.get(),
+      step->slack_upper_bound_gap.get(), step->slack_upper_bound_gap_dual.get()})
+      forEachEntry(dynamic_cast<DistributedVector<double>&>(*vec), [&](double& entry) { entry = random(); });
+
+   /* steps only move bounded gaps */
+   step->primal_lower_bound_gap->selectNonZeros(*problem->primal_lower_bound_indicators);
+   step->primal_lower_bound_gap_dual->selectNonZeros(*problem->primal_lower_bound_indicators);
+   step->primal_upper_bound_gap->selectNonZeros(*problem->primal_upper_bound_indicators);
+   step->primal_upper_bound_gap_dual->selectNonZeros(*problem->primal_upper_bound_indicators);
+   step->slack_lower_bound_gap->selectNonZeros(*problem->inequality_lower_bound_indicators);
+   step->slack_lower_bound_gap_dual->selectNonZeros(*problem->inequality_lower_bound_indicators);
+   step->slack_upper_bound_gap->selectNonZeros(*problem->inequality_upper_bound_indicators);
+   step->slack_upper_bound_gap_dual->selectNonZeros(*problem->inequality_upper_bound_indicators);
+
+   const double alpha_primal = 0.7;
+   const double alpha_dual = 0.4;
+
+   residuals->evaluate(*problem, *iterate);
+   EXPECT_NEAR(residuals->get_mu(), iterate->mu(), 1e-12 * (1.0 + iterate->mu()));
+
+   std::unique_ptr<Residuals> primal_change = residuals->clone_full();
+   std::unique_ptr<Residuals> dual_change = residuals->clone_full();
+   std::unique_ptr<Residuals> trial = residuals->clone_full();
+   primal_change->evaluate_step_change(*problem, *iterate, *step, *dual_change);
+   trial->evaluate_along_step(*residuals, *primal_change, *dual_change, alpha_primal, alpha_dual);
+
+   std::unique_ptr<Variables> trial_iterate = iterate->clone_full();
+   trial_iterate->add(*step, alpha_primal, alpha_dual);
+   std::unique_ptr<Residuals> expected = residuals->clone_full();
+   expected->evaluate(*problem, *trial_iterate);
+
+   auto expect_close = [](double actual, double reference) { EXPECT_NEAR(actual, reference, 1e-10 * (1.0 + std::fabs(reference))); };
+   expect_close(trial->get_residual_norm(), expected->get_residual_norm());
+   expect_close(trial->get_primal_objective(), expected->get_primal_objective());
+   expect_close(trial->get_dual_objective(), expected->get_dual_objective());
+   expect_close(trial->get_duality_gap(), expected->get_duality_gap());
+   expect_close(trial->get_mu(), trial_iterate->mu());
+}
@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+
+#include "DeSymIndefSolver.h"
+#include "DenseSymmetricMatrix.h"
+#include "DenseVector.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+/* the blocked root solves (solveReducedLinkConsBlocked) put several right-hand sides through the dense factor at once - each
+ * has to come out as in a single solve */
+class DeSymIndefSolverTest : public ::testing::TestWithParam<int> {
+protected:
+   /* random symmetric indefinite matrix with a zero lower right block (forcing 2x2 pivots) */
+   static void fillMatrix(DenseSymmetricMatrix& mat) {
+      const int n = static_cast<int>(mat.size());
+      std::mt19937 generator(4711);
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+      for (int row = 0; row < n; ++row) {
+         for (int col = 0; col <= row; ++col) {
+            const double value = col >= (n + 1) / 2 ? 0.0 : distribution(generator);
+            mat[row][col] = value;
+            mat[col][row] = value;
+         }
+      }
+   }
+};
+
+TEST_P(DeSymIndefSolverTest, MultipleRhsMatchSingleSolves) {
+   const int n = GetParam();
+   const int n_rhs = 4;
+
+   DenseSymmetricMatrix mat(n);
+   fillMatrix(mat);
+   DeSymIndefSolver solver(mat);
+   solver.matrixChanged();
+
+   /* the third right-hand side stays zero */
+   std::vector<double> rhss(static_cast<size_t>(n_rhs) * n, 0.0);
+   for (int r = 0; r < n_rhs; ++r) {
+      if (r == 2)
+         continue;
+      for (int i = 0; i < n; ++i)
+         rhss[static_cast<size_t>(r) * n + i] = (r + 1) * (1.0 + i % 7) - i;
+   }
+
+   std::vector<double> solutions = rhss;
+   solver.solve(n_rhs, solutions.data(), nullptr);
+
+   for (int r = 0; r < n_rhs; ++r) {
+      DenseVector<double> x(n);
+      std::copy(rhss.begin() + static_cast<size_t>(r) * n, rhss.begin() + static_cast<size_t>(r + 1) * n, &x[0]);
+      solver.solve(x);
+
+      for (int i = 0; i < n; ++i) {
+         const double multiple = solutions[static_cast<size_t>(r) * n + i];
+         EXPECT_NEAR(multiple, x[i], 1e-9 * n * (1.0 + std::fabs(x[i]))) << " rhs " << r << " entry " << i;
+      }
+   }
+}
+
+INSTANTIATE_TEST_SUITE_P(DeSymIndefSolverSizes, DeSymIndefSolverTest, ::testing::Values(2, 37, 150));
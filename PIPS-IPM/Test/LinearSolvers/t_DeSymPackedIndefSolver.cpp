@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+
+#include "DeSymPackedIndefSolver.h"
+#include "DeSymIndefSolver.h"
+#include "DenseSymmetricMatrix.h"
+#include "DenseMatrix.h"
+#include "DenseVector.hpp"
+
+#include <cmath>
+#include <random>
+#include <tuple>
+
+class DeSymPackedIndefSolverTest : public ::testing::TestWithParam<std::tuple<int, int, bool>> {
+protected:
+   /* random symmetric indefinite matrix - with kkt_structure the lower right block is zero (forcing 2x2 pivots) */
+   static void fillMatrix(DenseSymmetricMatrix& mat, bool kkt_structure) {
+      const int n = static_cast<int>(mat.size());
+      std::mt19937 generator(4711);
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+      for (int row = 0; row < n; ++row) {
+         for (int col = 0; col <= row; ++col) {
+            double value = distribution(generator);
+            if (kkt_structure && col >= n / 2)
+               value = 0.0;
+            if (row == col && !kkt_structure)
+               value *= n / 4.0;
+            mat[row][col] = value;
+            mat[col][row] = value;
+         }
+      }
+   }
+
+   static double residualNorm(const DenseSymmetricMatrix& mat, const double* x, const double* rhs) {
+      const int n = static_cast<int>(mat.size());
+      double norm = 0.0;
+      for (int row = 0; row < n; ++row) {
+         double res = rhs[row];
+         for (int col = 0; col < n; ++col)
+            res -= mat[row][col] * x[col];
+         norm = std::max(norm, std::fabs(res));
+      }
+      return norm;
+   }
+};
+
+TEST_P(DeSymPackedIndefSolverTest, SolveMatchesDeSymIndefSolver) {
+   const int n = std::get<0>(GetParam());
+   const int tile_size = std::get<1>(GetParam());
+   const bool kkt_structure = std::get<2>(GetParam());
+
+   DenseSymmetricMatrix mat(n);
+   fillMatrix(mat, kkt_structure);
+
+   DeSymPackedIndefSolver packed_solver(mat, tile_size);
+   DeSymIndefSolver reference_solver(mat);
+   packed_solver.matrixChanged();
+   reference_solver.matrixChanged();
+
+   EXPECT_EQ(packed_solver.get_inertia(), reference_solver.get_inertia());
+   if (kkt_structure) {
+      EXPECT_EQ(std::get<0>(packed_solver.get_inertia()), static_cast<unsigned int>(n / 2));
+      EXPECT_EQ(std::get<1>(packed_solver.get_inertia()), static_cast<unsigned int>(n - n / 2));
+   }
+
+   DenseVector<double> rhs(n);
+   for (int i = 0; i < n; ++i)
+      rhs[i] = 1.0 + i % 7;
+
+   DenseVector<double> x_packed(n);
+   DenseVector<double> x_reference(n);
+   x_packed.copyFrom(rhs);
+   x_reference.copyFrom(rhs);
+   packed_solver.solve(x_packed);
+   reference_solver.solve(x_reference);
+
+   const double tolerance = 1e-9 * n;
+   EXPECT_LT(residualNorm(mat, &x_packed[0], &rhs[0]), tolerance);
+   for (int i = 0; i < n; ++i)
+      EXPECT_NEAR(x_packed[i], x_reference[i], tolerance * (1.0 + std::fabs(x_reference[i])));
+
+   /* several right hand sides at once */
+   const int n_rhs = 3;
+   DenseMatrix rhs_mat(n_rhs, n);
+   for (int r = 0; r < n_rhs; ++r)
+      for (int i = 0; i < n; ++i)
+         rhs_mat[r][i] = (r + 1) * rhs[i] - i;
+   DenseMatrix x_mat(n_rhs, n);
+   for (int r = 0; r < n_rhs; ++r)
+      for (int i = 0; i < n; ++i)
+         x_mat[r][i] = rhs_mat[r][i];
+
+   packed_solver.solve(x_mat);
+   for (int r = 0; r < n_rhs; ++r)
+      EXPECT_LT(residualNorm(mat, x_mat[r], rhs_mat[r]), tolerance);
+}
+
+INSTANTIATE_TEST_SUITE_P(DeSymPackedIndefSolverTilings, DeSymPackedIndefSolverTest,
+   ::testing::Combine(::testing::Values(2, 38, 200), ::testing::Values(2, 4, 16, 128), ::testing::Bool()));
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+
+#include "Ma57Solver.h"
+#include "SparseSymmetricMatrix.h"
+#include "DenseVector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/* multiple right-hand sides are solved in blocks with blocked refinement - each has to come out as in a single solve */
+class Ma57SolverTest : public ::testing::TestWithParam<int> {
+protected:
+   static constexpr int nx = 40;
+   static constexpr int my = 25;
+   static constexpr int n = nx + my;
+
+   /* lower triangle of the saddle point matrix [H A^T; A 0] with diagonal H and A of full row rank */
+   static std::unique_ptr<SparseSymmetricMatrix> kktMatrix() {
+      std::vector<int> krowM{0};
+      std::vector<int> jcolM;
+      std::vector<double> M;
+
+      for (int row = 0; row < nx; ++row) {
+         jcolM.push_back(row);
+         M.push_back(1.0 + row % 3);
+         krowM.push_back(static_cast<int>(jcolM.size()));
+      }
+      for (int row = 0; row < my; ++row) {
+         jcolM.push_back(row);
+         M.push_back(2.0);
+         jcolM.push_back(row + my / 2);
+         M.push_back(-1.0 + 0.1 * row);
+         if (row + my < nx) {
+            jcolM.push_back(row + my);
+            M.push_back(0.5);
+         }
+         krowM.push_back(static_cast<int>(jcolM.size()));
+      }
+
+      const int nnz = static_cast<int>(jcolM.size());
+      auto* krowM_ = new int[n + 1];
+      auto* jcolM_ = new int[nnz];
+      auto* M_ = new double[nnz];
+      std::copy(krowM.begin(), krowM.end(), krowM_);
+      std::copy(jcolM.begin(), jcolM.end(), jcolM_);
+      std::copy(M.begin(), M.end(), M_);
+      return std::make_unique<SparseSymmetricMatrix>(n, nnz, krowM_, jcolM_, M_, 1);
+   }
+};
+
+TEST_P(Ma57SolverTest, MultipleRhsMatchSingleSolves) {
+   const int n_rhs = GetParam();
+
+   std::unique_ptr<SparseSymmetricMatrix> mat = kktMatrix();
+   Ma57Solver solver(*mat);
+   solver.matrixChanged();
+
+   /* every third right-hand side stays zero */
+   std::vector<double> rhss(static_cast<size_t>(n_rhs) * n, 0.0);
+   for (int r = 0; r < n_rhs; ++r) {
+      if (r % 3 == 2)
+         continue;
+      for (int i = 0; i < n; ++i)
+         rhss[static_cast<size_t>(r) * n + i] = (r + 1) * (1.0 + i % 7) - i;
+   }
+
+   std::vector<double> solutions = rhss;
+   solver.solve(n_rhs, solutions.data(), nullptr);
+
+   for (int r = 0; r < n_rhs; ++r) {
+      DenseVector<double> x(n);
+      std::copy(rhss.begin() + static_cast<size_t>(r) * n, rhss.begin() + static_cast<size_t>(r + 1) * n, &x[0]);
+      solver.solve(x);
+
+      for (int i = 0; i < n; ++i) {
+         const double multiple = solutions[static_cast<size_t>(r) * n + i];
+         EXPECT_NEAR(multiple, x[i], 1e-9 * (1.0 + std::fabs(x[i]))) << " rhs " << r << " entry " << i;
+      }
+   }
+}
+
+/* more right-hand sides than fit into one block */
+INSTANTIATE_TEST_SUITE_P(Ma57SolverRhsCounts, Ma57SolverTest, ::testing::Values(1, 4, 150));
@@ -0,0 +1,82 @@
+#include "gtest/gtest.h"
+
+#include "DeSymIndefSolver.h"
+#include "DenseSymmetricMatrix.h"
+#include "DenseVector.hpp"
+#include "NodeTopology.h"
+#include "PIPSIPMppOptions.h"
+
+#include <cmath>
+#include <random>
+
+/* run with 3 and 4 MPI processes - MPI_SIMULATED_RANKS_PER_NODE = 2 turns them into the nodes {0,1}, {2} and {0,1}, {2,3};
+ * the root Schur complement factor is only shared per node if all processes agree that every node can share it */
+class SharedDenseFactorTest : public ::testing::Test {
+protected:
+   static constexpr int ranks_per_node = 2;
+
+   static void SetUpTestSuite() {
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+      pipsipmpp_options::set_int_parameter("MPI_SIMULATED_RANKS_PER_NODE", ranks_per_node);
+      /* as done by PIPSIPMppInterface - has to happen before MPI_COMM_WORLD is split into nodes for the first time */
+      NodeTopology::setSimulatedRanksPerNode(pipsipmpp_options::get_int_parameter("MPI_SIMULATED_RANKS_PER_NODE"));
+   }
+
+   void SetUp() override {
+      if (PIPS_MPIgetSize() != 3 && PIPS_MPIgetSize() != 4)
+         GTEST_SKIP() << "needs 3 or 4 MPI processes";
+   }
+
+   /* the same random symmetric indefinite matrix on all processes */
+   static void fillMatrix(DenseSymmetricMatrix& mat) {
+      const int n = static_cast<int>(mat.size());
+      std::mt19937 generator(4711);
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+      for (int row = 0; row < n; ++row) {
+         for (int col = 0; col <= row; ++col) {
+            const double value = col >= (n + 1) / 2 ? 0.0 : distribution(generator);
+            mat[row][col] = value;
+            mat[col][row] = value;
+         }
+      }
+   }
+};
+
+TEST_F(SharedDenseFactorTest, DecisionIsTheSameOnAllProcesses) {
+   const bool own_node_shared = PIPS_MPIgetSize(NodeTopology::split(MPI_COMM_WORLD).node_comm) > 1;
+   const bool every_node_shared = NodeTopology::everyNodeShared(MPI_COMM_WORLD);
+
+   /* rank 2 is alone on its node with 3 processes - rank 0 and 1 must not share their factor either */
+   EXPECT_EQ(every_node_shared, PIPS_MPIgetSize() == 4);
+   if (PIPS_MPIgetSize() == 3) {
+      EXPECT_EQ(own_node_shared, PIPS_MPIgetRank() != 2);
+   }
+
+   EXPECT_EQ(PIPS_MPIgetSum(every_node_shared ? 1 : 0), every_node_shared ? PIPS_MPIgetSize() : 0);
+}
+
+TEST_F(SharedDenseFactorTest, SharedFactorSolvesAsTheOwnFactor) {
+   if (!NodeTopology::everyNodeShared(MPI_COMM_WORLD))
+      GTEST_SKIP() << "some node holds a single process";
+
+   const int n = 37;
+   DenseSymmetricMatrix mat(n);
+   fillMatrix(mat);
+
+   DeSymIndefSolver own(mat);
+   own.matrixChanged();
+   DeSymIndefSolver shared(mat, NodeTopology::split(MPI_COMM_WORLD).node_comm);
+   shared.matrixChanged();
+
+   DenseVector<double> x_own(n);
+   DenseVector<double> x_shared(n);
+   for (int i = 0; i < n; ++i)
+      x_own[i] = x_shared[i] = 1.0 + i % 7 - PIPS_MPIgetRank();
+
+   own.solve(x_own);
+   shared.solve(x_shared);
+
+   for (int i = 0; i < n; ++i)
+      EXPECT_NEAR(x_shared[i], x_own[i], 1e-9 * n * (1.0 + std::fabs(x_own[i]))) << " entry " << i;
+}
@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+
+#include "ReductionLog.h"
+
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace {
+   struct ExpectedReduction {
+      int type;
+      std::vector<INDEX> indices;
+      std::vector<double> float_values;
+      std::vector<int> int_values;
+   };
+
+   std::vector<ExpectedReduction> appendRandomReductions(ReductionLog& log, unsigned int n_reductions) {
+      std::mt19937 generator(815);
+      std::uniform_int_distribution<int> n_entries(0, 6);
+      std::uniform_int_distribution<int> node(-1, 9);
+      std::uniform_int_distribution<int> index(0, 100000);
+      std::uniform_int_distribution<int> int_value(-1000000, 1000000);
+      std::uniform_real_distribution<double> float_value(-1e20, 1e20);
+
+      std::vector<ExpectedReduction> expected;
+      for (unsigned int i = 0; i < n_reductions; ++i) {
+         ExpectedReduction reduction{static_cast<int>(i % 17), {}, {}, {}};
+
+         const int n_indices = n_entries(generator);
+         for (int j = 0; j < n_indices; ++j) {
+            switch (j % 3) {
+               case 0:
+                  reduction.indices.emplace_back(COL, node(generator), index(generator));
+                  break;
+               case 1: {
+                  /* linking rows live on node -1 */
+                  const bool linking = i % 5 == 0;
+                  reduction.indices.emplace_back(ROW, linking ? -1 : node(generator), index(generator), linking, i % 2 == 0 ? INEQUALITY_SYSTEM : EQUALITY_SYSTEM);
+                  break;
+               }
+               default:
+                  reduction.indices.emplace_back();
+            }
+         }
+         const int n_floats = n_entries(generator);
+         for (int j = 0; j < n_floats; ++j)
+            reduction.float_values.push_back(float_value(generator));
+         const int n_ints = n_entries(generator);
+         for (int j = 0; j < n_ints; ++j)
+            reduction.int_values.push_back(int_value(generator));
+
+         log.beginReduction(reduction.type);
+         for (const INDEX& idx : reduction.indices)
+            log.addIndex(idx);
+         for (double value : reduction.float_values)
+            log.addFloatValue(value);
+         for (int value : reduction.int_values)
+            log.addIntValue(value);
+         log.finishReduction();
+
+         expected.push_back(std::move(reduction));
+      }
+      return expected;
+   }
+
+   void expectReduction(const ReductionLog& log, unsigned int i, const ExpectedReduction& expected) {
+      const ReductionLog::Record record = log.getReduction(i);
+      ASSERT_EQ(record.type, expected.type) << " reduction " << i;
+      ASSERT_EQ(record.n_indices, expected.indices.size()) << " reduction " << i;
+      ASSERT_EQ(record.n_float_values, expected.float_values.size()) << " reduction " << i;
+      ASSERT_EQ(record.n_int_values, expected.int_values.size()) << " reduction " << i;
+
+      for (unsigned int j = 0; j < record.n_indices; ++j)
+         EXPECT_EQ(record.index(j), expected.indices[j]) << " reduction " << i << " index " << j;
+      for (unsigned int j = 0; j < record.n_float_values; ++j)
+         EXPECT_EQ(record.floatValue(j), expected.float_values[j]) << " reduction " << i << " double " << j;
+      for (unsigned int j = 0; j < record.n_int_values; ++j)
+         EXPECT_EQ(record.intValue(j), expected.int_values[j]) << " reduction " << i << " int " << j;
+   }
+}
+
+/* spill limit in bytes (-1 keeps everything in memory) and chunk size */
+class ReductionLogTest : public ::testing::TestWithParam<std::tuple<long long, size_t>> {
+};
+
+TEST_P(ReductionLogTest, RoundTripBackwardsAndForwards) {
+   const long long spill_limit = std::get<0>(GetParam());
+   const size_t chunk_bytes = std::get<1>(GetParam());
+   const unsigned int n_reductions = 5000;
+
+   ReductionLog log(spill_limit, chunk_bytes);
+   const std::vector<ExpectedReduction> expected = appendRandomReductions(log, n_reductions);
+   ASSERT_EQ(log.size(), n_reductions);
+
+   if (spill_limit < 0)
+      EXPECT_EQ(log.spilledBytes(), 0u);
+   else
+      EXPECT_GT(log.spilledBytes(), 0u);
+
+   /* postsolve order */
+   for (unsigned int i = n_reductions; i-- > 0;)
+      expectReduction(log, i, expected[i]);
+
+   /* presolve side lookups jump around */
+   for (unsigned int i = 0; i < n_reductions; i += 7)
+      expectReduction(log, i, expected[i]);
+}
+
+TEST_P(ReductionLogTest, MarkDeletedOverridesType) {
+   const long long spill_limit = std::get<0>(GetParam());
+   const size_t chunk_bytes = std::get<1>(GetParam());
+   const unsigned int n_reductions = 2000;
+   const int deleted_type = 99;
+
+   ReductionLog log(spill_limit, chunk_bytes);
+   const std::vector<ExpectedReduction> expected = appendRandomReductions(log, n_reductions);
+
+   for (unsigned int i = 0; i < n_reductions; i += 3)
+      log.markDeleted(i, deleted_type);
+
+   for (unsigned int i = n_reductions; i-- > 0;) {
+      if (i % 3 == 0)
+         EXPECT_EQ(log.getReduction(i).type, deleted_type);
+      else
+         expectReduction(log, i, expected[i]);
+   }
+}
+
+TEST_P(ReductionLogTest, AppendAfterReadBack) {
+   const long long spill_limit = std::get<0>(GetParam());
+   const size_t chunk_bytes = std::get<1>(GetParam());
+
+   ReductionLog log(spill_limit, chunk_bytes);
+   const std::vector<ExpectedReduction> expected = appendRandomReductions(log, 1000);
+   expectReduction(log, 0, expected[0]);
+   expectReduction(log, 999, expected[999]);
+
+   log.beginReduction(3);
+   log.addIndex(INDEX(COL, 4, 17));
+   log.addFloatValue(-2.5);
+   log.addIntValue(42);
+   log.finishReduction();
+
+   ASSERT_EQ(log.size(), 1001u);
+   expectReduction(log, 1000, {3, {INDEX(COL, 4, 17)}, {-2.5}, {42}});
+   expectReduction(log, 500, expected[500]);
+}
+
+INSTANTIATE_TEST_SUITE_P(ReductionLogSpilling, ReductionLogTest,
+   ::testing::Combine(::testing::Values(-1LL, 0LL, 4096LL), ::testing::Values(size_t{256}, size_t{1} << 16)));
@@ -0,0 +1,324 @@
+#include "gtest/gtest.h"
+
+#include "DistributedFactory.hpp"
+#include "DistributedProblem.hpp"
+#include "DistributedInputTree.h"
+#include "PresolveData.h"
+#include "StochPresolverModelCleanup.h"
+#include "StochPresolverParallelRows.h"
+#include "StochPresolverBoundStrengthening.h"
+#include "DistributedVectorUtilities.h"
+#include "PIPSIPMppOptions.h"
+
+#include <omp.h>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/* the children are presolved in parallel - the outcome has to be the one of a single-threaded run
+ *
+ *    root:      x_0 + x_1 = 1
+ *    child i:   y_0 + y_1 = s_i,  y_1 - y_2 = 0,  2 y_0 + 2 y_1 = 2 s_i,  x_1 + y_2 <= 3
+ *
+ * with s_i = 1 + i / 10 and 0 <= x, y <= 10 - the first and last equality of every child are parallel
+ */
+class StochPresolversTest : public ::testing::Test {
+protected:
+   static constexpr int n_children = 8;
+   static constexpr double upper_bound = 10.0;
+
+   struct CSR {
+      std::vector<int> krowM;
+      std::vector<int> jcolM;
+      std::vector<double> M;
+
+      [[nodiscard]] int nnz() const { return static_cast<int>(jcolM.size()); }
+   };
+
+   static const CSR& matrixA(int id) {
+      static const CSR A0{{0, 2}, {0, 1}, {1.0, 1.0}};
+      static const CSR A{{0, 0, 0, 0}, {}, {}};
+      return id == -1 ? A0 : A;
+   }
+
+   static const CSR& matrixB() {
+      static const CSR B{{0, 2, 4, 6}, {0, 1, 1, 2, 0, 1}, {1.0, 1.0, 1.0, -1.0, 2.0, 2.0}};
+      return B;
+   }
+
+   static const CSR& matrixC(int id) {
+      static const CSR C0{{0}, {}, {}};
+      static const CSR C{{0, 1}, {1}, {1.0}};
+      return id == -1 ? C0 : C;
+   }
+
+   static const CSR& matrixD() {
+      static const CSR D{{0, 1}, {2}, {1.0}};
+      return D;
+   }
+
+   static double scenarioRhs(int id) {
+      return 1.0 + 0.1 * id;
+   }
+
+   static void copy(const CSR& csr, int* krowM, int* jcolM, double* M) {
+      std::memcpy(krowM, csr.krowM.data(), csr.krowM.size() * sizeof(int));
+      std::memcpy(jcolM, csr.jcolM.data(), csr.jcolM.size() * sizeof(int));
+      std::memcpy(M, csr.M.data(), csr.M.size() * sizeof(double));
+   }
+
+   static int fn(void*, int id, int* n) {
+      *n = id == -1 ? 2 : 3;
+      return 0;
+   }
+
+   static int fmy(void*, int id, int* my) {
+      *my = id == -1 ? 1 : 3;
+      return 0;
+   }
+
+   static int fmz(void*, int id, int* mz) {
+      *mz = id == -1 ? 0 : 1;
+      return 0;
+   }
+
+   static int fnnzQ(void*, int, int* nnz) {
+      *nnz = 0;
+      return 0;
+   }
+
+   static int fnnzA(void*, int id, int* nnz) {
+      *nnz = matrixA(id).nnz();
+      return 0;
+   }
+
+   static int fnnzB(void*, int, int* nnz) {
+      *nnz = matrixB().nnz();
+      return 0;
+   }
+
+   static int fnnzC(void*, int id, int* nnz) {
+      *nnz = matrixC(id).nnz();
+      return 0;
+   }
+
+   static int fnnzD(void*, int, int* nnz) {
+      *nnz = matrixD().nnz();
+      return 0;
+   }
+
+   static int fQ(void*, int id, int* krowM, int*, double*) {
+      int n;
+      fn(nullptr, id, &n);
+      std::fill(krowM, krowM + n + 1, 0);
+      return 0;
+   }
+
+   static int fA(void*, int id, int* krowM, int* jcolM, double* M) {
+      copy(matrixA(id), krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fB(void*, int, int* krowM, int* jcolM, double* M) {
+      copy(matrixB(), krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fC(void*, int id, int* krowM, int* jcolM, double* M) {
+      copy(matrixC(id), krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fD(void*, int, int* krowM, int* jcolM, double* M) {
+      copy(matrixD(), krowM, jcolM, M);
+      return 0;
+   }
+
+   static int fb(void*, int id, double* vec, int len) {
+      if (id == -1)
+         vec[0] = 1.0;
+      else {
+         assert(len == 3);
+         vec[0] = scenarioRhs(id);
+         vec[1] = 0.0;
+         vec[2] = 2.0 * scenarioRhs(id);
+      }
+      return 0;
+   }
+
+   static int fill(double* vec, int len, double value) {
+      std::fill(vec, vec + len, value);
+      return 0;
+   }
+
+   static int fc(void*, int, double* vec, int len) { return fill(vec, len, 1.0); }
+   static int fbl(void*, int, double* vec, int len) { return fill(vec, len, 0.0); }
+   static int fclow(void*, int, double* vec, int len) { return fill(vec, len, 0.0); }
+   static int ficlow(void*, int, double* vec, int len) { return fill(vec, len, 0.0); }
+   static int fcupp(void*, int, double* vec, int len) { return fill(vec, len, 3.0); }
+   static int ficupp(void*, int, double* vec, int len) { return fill(vec, len, 1.0); }
+   static int fxlow(void*, int, double* vec, int len) { return fill(vec, len, 0.0); }
+   static int fixlow(void*, int, double* vec, int len) { return fill(vec, len, 1.0); }
+   static int fxupp(void*, int, double* vec, int len) { return fill(vec, len, upper_bound); }
+   static int fixupp(void*, int, double* vec, int len) { return fill(vec, len, 1.0); }
+
+   /* no linking constraints - the (empty) linking vectors are read with the callbacks of their non-linking counterparts */
+   static std::unique_ptr<DistributedInputTree::DistributedInputNode> node(int id) {
+      const bool root = id == -1;
+      return std::make_unique<DistributedInputTree::DistributedInputNode>(nullptr, id, fn, fmy, nullptr, fmz, nullptr, fQ, fnnzQ, fc, fA, fnnzA,
+            root ? nullptr : fB, root ? nullptr : fnnzB, nullptr, nullptr, fb, fbl, fC, fnnzC, root ? nullptr : fD, root ? nullptr : fnnzD, nullptr,
+            nullptr, fclow, ficlow, fcupp, ficupp, fclow, ficlow, fcupp, ficupp, fxlow, fixlow, fxupp, fixupp, nullptr);
+   }
+
+   static void SetUpTestSuite() {
+      pipsipmpp_options::set_bool_parameter("SILENT", true);
+   }
+
+   void SetUp() override {
+      if (PIPS_MPIgetSize() > n_children)
+         GTEST_SKIP() << "the tree has only " << n_children << " children";
+
+      input_tree = std::make_unique<DistributedInputTree>(node(-1));
+      for (int child = 0; child < n_children; ++child)
+         input_tree->add_child(node(child));
+
+      factory = std::make_unique<DistributedFactory>(input_tree.get(), MPI_COMM_WORLD);
+      problem.reset(dynamic_cast<DistributedProblem*>(factory->make_problem().release()));
+      ASSERT_TRUE(problem);
+   }
+
+   /* the parts of the presolved problem the presolvers under test change */
+   struct Snapshot {
+      std::vector<double> xlow;
+      std::vector<double> xupp;
+      std::vector<double> b;
+      std::vector<int> nnzs_row_A;
+      std::vector<int> nnzs_row_C;
+   };
+
+   template<typename T>
+   static void append(std::vector<T>& values, const DenseVector<T>& vec) {
+      for (int i = 0; i < vec.length(); ++i)
+         values.push_back(vec[i]);
+   }
+
+   static Snapshot snapshot(const PresolveData& presolve_data) {
+      const DistributedProblem& prob = presolve_data.getPresProb();
+
+      Snapshot snapshot;
+      for (int node = -1; node < n_children; ++node) {
+         if (presolve_data.nodeIsDummy(node))
+            continue;
+         append(snapshot.xlow, getSimpleVecFromColStochVec(*prob.primal_lower_bounds, node));
+         append(snapshot.xupp, getSimpleVecFromColStochVec(*prob.primal_upper_bounds, node));
+         append(snapshot.b, getSimpleVecFromRowStochVec(*prob.equality_rhs, node, false));
+         append(snapshot.nnzs_row_A, getSimpleVecFromRowStochVec(presolve_data.getNnzsRowA(), node, false));
+         append(snapshot.nnzs_row_C, getSimpleVecFromRowStochVec(presolve_data.getNnzsRowC(), node, false));
+      }
+      return snapshot;
+   }
+
+   template<typename Presolver>
+   void apply(PresolveData& presolve_data) const {
+      Presolver presolver(presolve_data, *problem);
+      presolver.applyPresolving();
+   }
+
+   /* model cleanup, parallel rows and bound strengthening with the given number of threads */
+   Snapshot presolve(int n_threads) const {
+      const int n_threads_before = omp_get_max_threads();
+      omp_set_num_threads(n_threads);
+
+      PresolveData presolve_data(*problem, nullptr);
+      apply<StochPresolverModelCleanup>(presolve_data);
+      apply<StochPresolverParallelRows>(presolve_data);
+      apply<StochPresolverBoundStrengthening>(presolve_data);
+
+      omp_set_num_threads(n_threads_before);
+      return snapshot(presolve_data);
+   }
+
+   std::unique_ptr<DistributedInputTree> input_tree;
+   std::unique_ptr<DistributedFactory> factory;
+   std::unique_ptr<DistributedProblem> problem;
+};
+
+TEST_F(StochPresolversTest, ParallelRowsAreRemovedOncePerChild) {
+   PresolveData presolve_data(*problem, nullptr);
+   apply<StochPresolverModelCleanup>(presolve_data);
+   apply<StochPresolverParallelRows>(presolve_data);
+
+   for (int child = 0; child < n_children; ++child) {
+      if (presolve_data.nodeIsDummy(child))
+         continue;
+      const DenseVector<int>& nnzs_row = getSimpleVecFromRowStochVec(presolve_data.getNnzsRowA(), child, false);
+      const DenseVector<double>& b = getSimpleVecFromRowStochVec(*presolve_data.getPresProb().equality_rhs, child, false);
+
+      /* one of the parallel rows is gone, the other one and the row that is not parallel to anything remain */
+      EXPECT_EQ(nnzs_row[0] + nnzs_row[2], 2) << " child " << child;
+      EXPECT_TRUE(nnzs_row[0] == 0 || nnzs_row[2] == 0) << " child " << child;
+      EXPECT_EQ(nnzs_row[1], 2) << " child " << child;
+
+      const int kept = nnzs_row[0] == 0 ? 2 : 0;
+      EXPECT_DOUBLE_EQ(b[kept], (kept + 1) * scenarioRhs(child)) << " child " << child;
+   }
+}
+
+TEST_F(StochPresolversTest, ThreadCountDoesNotChangeResult) {
+   const Snapshot single_threaded = presolve(1);
+
+   for (int n_threads : {2, 3, n_children}) {
+      const Snapshot multi_threaded = presolve(n_threads);
+      EXPECT_EQ(multi_threaded.xlow, single_threaded.xlow) << " with " << n_threads << " threads";
+      EXPECT_EQ(multi_threaded.xupp, single_threaded.xupp) << " with " << n_threads << " threads";
+      EXPECT_EQ(multi_threaded.b, single_threaded.b) << " with " << n_threads << " threads";
+      EXPECT_EQ(multi_threaded.nnzs_row_A, single_threaded.nnzs_row_A) << " with " << n_threads << " threads";
+      EXPECT_EQ(multi_threaded.nnzs_row_C, single_threaded.nnzs_row_C) << " with " << n_threads << " threads";
+   }
+
+   /* the presolvers did something that could have differed */
+   EXPECT_NE(single_threaded.xupp, std::vector<double>(single_threaded.xupp.size(), upper_bound));
+}
+
+/* the first round tightens y_0, y_1 <= s_i from the parallel equalities and y_2 <= 3 from the inequality - y_1 - y_2 = 0 only carries
+ * y_1 <= s_i over to y_2 when it is examined again in the next round because the bound of y_1 changed */
+TEST_F(StochPresolversTest, BoundStrengtheningRevisitsRowsOfTightenedColumns) {
+   const int max_iter_before = pipsipmpp_options::get_int_parameter("PRESOLVE_BOUND_STR_MAX_ITER");
+
+   for (int max_iter : {1, 2, 5}) {
+      pipsipmpp_options::set_int_parameter("PRESOLVE_BOUND_STR_MAX_ITER", max_iter);
+
+      PresolveData presolve_data(*problem, nullptr);
+      apply<StochPresolverModelCleanup>(presolve_data);
+      apply<StochPresolverBoundStrengthening>(presolve_data);
+
+      const DistributedProblem& prob = presolve_data.getPresProb();
+      const DenseVector<double>& xupp_root = getSimpleVecFromColStochVec(*prob.primal_upper_bounds, -1);
+      EXPECT_DOUBLE_EQ(xupp_root[0], 1.0) << " after at most " << max_iter << " rounds";
+      EXPECT_DOUBLE_EQ(xupp_root[1], 1.0) << " after at most " << max_iter << " rounds";
+
+      for (int child = 0; child < n_children; ++child) {
+         if (presolve_data.nodeIsDummy(child))
+            continue;
+         const DenseVector<double>& xupp = getSimpleVecFromColStochVec(*prob.primal_upper_bounds, child);
+         const DenseVector<double>& ixupp = getSimpleVecFromColStochVec(*prob.primal_upper_bound_indicators, child);
+
+         EXPECT_DOUBLE_EQ(xupp[0], scenarioRhs(child)) << " child " << child << " after at most " << max_iter << " rounds";
+         EXPECT_DOUBLE_EQ(xupp[1], scenarioRhs(child)) << " child " << child << " after at most " << max_iter << " rounds";
+         EXPECT_DOUBLE_EQ(xupp[2], max_iter == 1 ? 3.0 : scenarioRhs(child)) << " child " << child << " after at most " << max_iter << " rounds";
+         for (int i = 0; i < 3; ++i)
+            EXPECT_EQ(ixupp[i], 1.0) << " child " << child;
+      }
+
+      /* a new run starts out examining every row - it only finds something if the last one stopped before the bounds settled */
+      StochPresolverBoundStrengthening again(presolve_data, *problem);
+      EXPECT_EQ(again.applyPresolving(), max_iter == 1) << " after at most " << max_iter << " rounds";
+      for (int child = 0; child < n_children; ++child) {
+         if (presolve_data.nodeIsDummy(child))
+            continue;
+         EXPECT_DOUBLE_EQ(getSimpleVecFromColStochVec(*prob.primal_upper_bounds, child)[2], scenarioRhs(child)) << " child " << child;
+      }
+   }
+
+   pipsipmpp_options::set_int_parameter("PRESOLVE_BOUND_STR_MAX_ITER", max_iter_before);
+}
@@ -0,0 +1,279 @@
+#include "gtest/gtest.h"
+
+#include "DistributedMatrix.h"
+#include "DistributedVector.h"
+#include "SparseMatrix.h"
+#include "DenseVector.hpp"
+#include "mpi.h"
+
+#include <omp.h>
+
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+/* the child loops of the products and min/max scans run threaded whenever all children are sparse leaves - every result,
+ * in particular the linking parts the threads accumulate into, has to match the serial computation */
+class DistributedMatrixThreadedTest : public ::testing::Test {
+protected:
+   static constexpr int n_children = 9;
+   static constexpr int n_threads = 4;
+   static constexpr int n0 = 20, m0 = 10, m_link = 200, n_child = 40, m_child = 30;
+
+   std::mt19937 generator{4711};
+   const MPI_Comm comm{MPI_COMM_SELF};
+   int n_threads_before{1};
+
+   std::shared_ptr<DistributedMatrix> mat;
+
+   double random(double lower = -2.0, double upper = 2.0) { return std::uniform_real_distribution<double>(lower, upper)(generator); };
+
+   std::unique_ptr<SparseMatrix> randomSparse(int m, int n) {
+      std::vector<double> dense(static_cast<size_t>(m) * n);
+      int nnz = 0;
+      for (double& entry : dense) {
+         entry = random(0.0, 1.0) < 0.5 ? random() : 0.0;
+         nnz += entry != 0.0;
+      }
+
+      auto sparse = std::make_unique<SparseMatrix>(m, n, nnz);
+      SparseStorage& storage = sparse->getStorage();
+      int pos = 0;
+      for (int row = 0; row < m; ++row) {
+         storage.krowM[row] = pos;
+         for (int col = 0; col < n; ++col) {
+            if (dense[static_cast<size_t>(row) * n + col] != 0.0) {
+               storage.jcolM[pos] = col;
+               storage.M[pos] = dense[static_cast<size_t>(row) * n + col];
+               ++pos;
+            }
+         }
+      }
+      storage.krowM[m] = pos;
+      return sparse;
+   }
+
+   std::unique_ptr<DistributedVector<double>> columnVector() const {
+      auto vec = std::make_unique<DistributedVector<double>>(n0, comm);
+      for (int i = 0; i < n_children; ++i)
+         vec->AddChild(std::make_shared<DistributedVector<double>>(n_child, comm));
+      return vec;
+   }
+
+   std::unique_ptr<DistributedVector<double>> rowVector() const {
+      auto vec = std::make_unique<DistributedVector<double>>(m0, m_link, comm);
+      for (int i = 0; i < n_children; ++i)
+         vec->AddChild(std::make_shared<DistributedVector<double>>(m_child, comm));
+      return vec;
+   }
+
+   static void forEachEntry(DistributedVector<double>& vec, const std::function<void(double&)>& f) {
+      for (auto* part : {vec.first.get(), vec.last.get()}) {
+         if (!part)
+            continue;
+         auto& dense = dynamic_cast<DenseVector<double>&>(*part);
+         for (int i = 0; i < dense.length(); ++i)
+            f(dense[i]);
+      }
+      for (auto& child : vec.children)
+         forEachEntry(*child, f);
+   }
+
+   std::unique_ptr<DistributedVector<double>> randomVector(std::unique_ptr<DistributedVector<double>> vec) {
+      forEachEntry(*vec, [&](double& entry) { entry = random(); });
+      return vec;
+   }
+
+   static std::vector<double> entries(DistributedVector<double>& vec) {
+      std::vector<double> values;
+      forEachEntry(vec, [&](double& entry) { values.push_back(entry); });
+      return values;
+   }
+
+   static void expectNear(const std::vector<double>& threaded, const std::vector<double>& serial) {
+      ASSERT_EQ(threaded.size(), serial.size());
+      for (size_t i = 0; i < serial.size(); ++i)
+         EXPECT_NEAR(threaded[i], serial[i], 1e-12 * (1.0 + std::fabs(serial[i]))) << " at entry " << i;
+   }
+
+   /* runs compute once serially and once with n_threads threads */
+   template<typename Compute>
+   void compareThreadedWithSerial(const Compute& compute) {
+      omp_set_num_threads(1);
+      const std::vector<double> serial = compute();
+      omp_set_num_threads(n_threads);
+      const std::vector<double> threaded = compute();
+      expectNear(threaded, serial);
+   }
+
+   void SetUp() override {
+      n_threads_before = omp_get_max_threads();
+
+      mat = std::make_shared<DistributedMatrix>(std::make_unique<SparseMatrix>(m0, 0, 0), randomSparse(m0, n0), randomSparse(m_link, n0), comm);
+      for (int i = 0; i < n_children; ++i)
+         mat->AddChild(std::make_shared<DistributedMatrix>(randomSparse(m_child, n0), randomSparse(m_child, n_child), randomSparse(m_link, n_child), comm));
+      mat->recomputeSize();
+   }
+
+   void TearDown() override {
+      omp_set_num_threads(n_threads_before);
+   }
+};
+
+TEST_F(DistributedMatrixThreadedTest, MultMatchesSerial) {
+   const auto x = randomVector(columnVector());
+   const auto y_start = randomVector(rowVector());
+
+   compareThreadedWithSerial([&]() {
+      std::unique_ptr<DistributedVector<double>> y{dynamic_cast<DistributedVector<double>*>(y_start->clone_full())};
+      mat->mult(0.5, *y, -1.5, *x);
+      return entries(*y);
+   });
+}
+
+TEST_F(DistributedMatrixThreadedTest, TransposeMultMatchesSerial) {
+   const auto x = randomVector(rowVector());
+   const auto y_start = randomVector(columnVector());
+
+   compareThreadedWithSerial([&]() {
+      std::unique_ptr<DistributedVector<double>> y{dynamic_cast<DistributedVector<double>*>(y_start->clone_full())};
+      mat->transpose_mult(0.5, *y, -1.5, *x);
+      return entries(*y);
+   });
+}
+
+TEST_F(DistributedMatrixThreadedTest, RowMinAndMaxMatchSerial) {
+   const auto col_scale = randomVector(columnVector());
+
+   compareThreadedWithSerial([&]() {
+      auto min = rowVector();
+      auto max = rowVector();
+      mat->getRowMinAndMaxVec(true, col_scale.get(), *min, *max);
+      std::vector<double> values = entries(*min);
+      const std::vector<double> max_values = entries(*max);
+      values.insert(values.end(), max_values.begin(), max_values.end());
+      return values;
+   });
+}
+
+TEST_F(DistributedMatrixThreadedTest, ColMinAndMaxMatchSerial) {
+   const auto row_scale = randomVector(rowVector());
+
+   compareThreadedWithSerial([&]() {
+      auto min = columnVector();
+      auto max = columnVector();
+      mat->getColMinAndMaxVec(true, row_scale.get(), *min, *max);
+      std::vector<double> values = entries(*min);
+      const std::vector<double> max_values = entries(*max);
+      values.insert(values.end(), max_values.begin(), max_values.end());
+      return values;
+   });
+}
+
+/* products with the same matrix from several threads at once must not share the linking accumulators */
+TEST_F(DistributedMatrixThreadedTest, ConcurrentProductsMatchSerial) {
+   constexpr int n_products = 4;
+   std::vector<std::unique_ptr<DistributedVector<double>>> xs;
+   for (int i = 0; i < n_products; ++i)
+      xs.push_back(randomVector(columnVector()));
+
+   omp_set_num_threads(1);
+   std::vector<std::vector<double>> serial;
+   for (const auto& x : xs) {
+      auto y = rowVector();
+      mat->mult(0.0, *y, 1.0, *x);
+      serial.push_back(entries(*y));
+   }
+
+   /* with nesting the inner child loops run threaded as well and all threads write their linking parts */
+   const int max_active_levels_before = omp_get_max_active_levels();
+   omp_set_max_active_levels(2);
+   omp_set_num_threads(n_threads);
+   std::vector<std::unique_ptr<DistributedVector<double>>> ys;
+   for (int i = 0; i < n_products; ++i)
+      ys.push_back(rowVector());
+
+   for (int repetition = 0; repetition < 50; ++repetition) {
+#pragma omp parallel for num_threads(n_products) schedule(static, 1)
+      for (int i = 0; i < n_products; ++i)
+         mat->mult(0.0, *ys[i], 1.0, *xs[i]);
+
+      for (int i = 0; i < n_products; ++i)
+         expectNear(entries(*ys[i]), serial[i]);
+   }
+
+   omp_set_max_active_levels(max_active_levels_before);
+}
+
+/* the combined scans replace a min and a max scan each - also when they continue from the values of another matrix (initializeVec false) */
+TEST_F(DistributedMatrixThreadedTest, MinAndMaxMatchSeparateScans) {
+   omp_set_num_threads(n_threads);
+   const auto col_scale = randomVector(columnVector());
+   const auto row_scale = randomVector(rowVector());
+
+   for (const bool scaled : {false, true}) {
+      auto min = rowVector(), max = rowVector(), min_separate = rowVector(), max_separate = rowVector();
+      for (const bool initialize : {true, false}) {
+         mat->getRowMinAndMaxVec(initialize, scaled ? col_scale.get() : nullptr, *min, *max);
+         mat->getRowMinMaxVec(true, initialize, scaled ? col_scale.get() : nullptr, *min_separate);
+         mat->getRowMinMaxVec(false, initialize, scaled ? col_scale.get() : nullptr, *max_separate);
+         expectNear(entries(*min), entries(*min_separate));
+         expectNear(entries(*max), entries(*max_separate));
+      }
+   }
+
+   for (const bool scaled : {false, true}) {
+      auto min = columnVector(), max = columnVector(), min_separate = columnVector(), max_separate = columnVector();
+      for (const bool initialize : {true, false}) {
+         mat->getColMinAndMaxVec(initialize, scaled ? row_scale.get() : nullptr, *min, *max);
+         mat->getColMinMaxVec(true, initialize, scaled ? row_scale.get() : nullptr, *min_separate);
+         mat->getColMinMaxVec(false, initialize, scaled ? row_scale.get() : nullptr, *max_separate);
+         expectNear(entries(*min), entries(*min_separate));
+         expectNear(entries(*max), entries(*max_separate));
+      }
+   }
+}
+
+/* min/max scans of the same matrix from several threads at once - the linking parts are accumulated per call, not in the matrix */
+TEST_F(DistributedMatrixThreadedTest, ConcurrentMinAndMaxScansMatchSerial) {
+   constexpr int n_scans = 4;
+   std::vector<std::unique_ptr<DistributedVector<double>>> col_scales;
+   for (int i = 0; i < n_scans; ++i)
+      col_scales.push_back(randomVector(columnVector()));
+
+   const auto scan = [&](int i, DistributedVector<double>& min, DistributedVector<double>& max) {
+      mat->getRowMinAndMaxVec(true, col_scales[i].get(), min, max);
+   };
+
+   omp_set_num_threads(1);
+   std::vector<std::vector<double>> serial_min, serial_max;
+   for (int i = 0; i < n_scans; ++i) {
+      auto min = rowVector(), max = rowVector();
+      scan(i, *min, *max);
+      serial_min.push_back(entries(*min));
+      serial_max.push_back(entries(*max));
+   }
+
+   const int max_active_levels_before = omp_get_max_active_levels();
+   omp_set_max_active_levels(2);
+   omp_set_num_threads(n_threads);
+   std::vector<std::unique_ptr<DistributedVector<double>>> mins, maxs;
+   for (int i = 0; i < n_scans; ++i) {
+      mins.push_back(rowVector());
+      maxs.push_back(rowVector());
+   }
+
+   for (int repetition = 0; repetition < 50; ++repetition) {
+#pragma omp parallel for num_threads(n_scans) schedule(static, 1)
+      for (int i = 0; i < n_scans; ++i)
+         scan(i, *mins[i], *maxs[i]);
+
+      for (int i = 0; i < n_scans; ++i) {
+         expectNear(entries(*mins[i]), serial_min[i]);
+         expectNear(entries(*maxs[i]), serial_max[i]);
+      }
+   }
+
+   omp_set_max_active_levels(max_active_levels_before);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include "DistributedVector.h"
+#include "DenseVector.hpp"
+#include "mpi.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* writeBlocksToFile writes the root, every child (from its owner only) and the linking part - the file has to contain all
+ * of them in order no matter how the children are spread over the processes */
+class DistributedVectorBlockFileTest : public ::testing::Test {
+protected:
+   static constexpr int n_children = 5;
+   static constexpr int n0 = 7, n_link = 3;
+
+   const MPI_Comm comm{MPI_COMM_WORLD};
+   const int my_rank{PIPS_MPIgetRank(comm)};
+   const int size{PIPS_MPIgetSize(comm)};
+
+   static int childLength(int child) { return 4 + 3 * child; }
+   static double value(int block, int i) { return 1000.0 * block + 0.5 * i; }
+
+   static void fill(DenseVector<double>& vec, int block) {
+      for (int i = 0; i < vec.length(); ++i)
+         vec[i] = value(block, i);
+   }
+
+   /* child i lives on process i % size - everybody else holds a dummy */
+   std::unique_ptr<DistributedVector<double>> blockVector() const {
+      auto vec = std::make_unique<DistributedVector<double>>(n0, n_link, comm);
+      fill(dynamic_cast<DenseVector<double>&>(*vec->first), 0);
+      fill(dynamic_cast<DenseVector<double>&>(*vec->last), n_children + 1);
+
+      for (int child = 0; child < n_children; ++child) {
+         if (child % size == my_rank) {
+            auto child_vec = std::make_shared<DistributedVector<double>>(childLength(child), comm);
+            fill(dynamic_cast<DenseVector<double>&>(*child_vec->first), child + 1);
+            vec->AddChild(child_vec);
+         } else
+            vec->AddChild(std::make_shared<DistributedDummyVector<double>>());
+      }
+      return vec;
+   }
+
+   template<typename Value>
+   static Value readValue(std::ifstream& file) {
+      Value value{};
+      file.read(reinterpret_cast<char*>(&value), sizeof(Value));
+      return value;
+   }
+};
+
+TEST_F(DistributedVectorBlockFileTest, FileHoldsAllBlocksInOrder) {
+   const std::string file_name = ::testing::TempDir() + "pips_block_file_test_" + std::to_string(size) + ".bin";
+
+   blockVector()->writeBlocksToFile(file_name);
+   MPI_Barrier(comm);
+
+   if (my_rank == 0) {
+      std::ifstream file(file_name, std::ios::binary);
+      ASSERT_TRUE(file.good());
+
+      char magic[8];
+      file.read(magic, sizeof(magic));
+      EXPECT_EQ(std::string(magic, sizeof(magic)), "PIPSBLK1");
+
+      std::vector<long long> lengths{n0};
+      for (int child = 0; child < n_children; ++child)
+         lengths.push_back(childLength(child));
+      lengths.push_back(n_link);
+      const int n_blocks = static_cast<int>(lengths.size());
+
+      long long total_length = 0;
+      for (long long length : lengths)
+         total_length += length;
+
+      EXPECT_EQ(readValue<long long>(file), n_blocks);
+      EXPECT_EQ(readValue<long long>(file), static_cast<long long>(sizeof(double)));
+      EXPECT_EQ(readValue<long long>(file), total_length);
+
+      long long expected_offset = 0;
+      for (int block = 0; block < n_blocks; ++block) {
+         EXPECT_EQ(readValue<long long>(file), expected_offset) << " block " << block;
+         EXPECT_EQ(readValue<long long>(file), lengths[block]) << " block " << block;
+         expected_offset += lengths[block];
+      }
+
+      for (int block = 0; block < n_blocks; ++block) {
+         for (int i = 0; i < lengths[block]; ++i)
+            EXPECT_EQ(readValue<double>(file), value(block, i)) << " block " << block << " entry " << i;
+      }
+
+      file.peek();
+      EXPECT_TRUE(file.eof());
+      file.close();
+      std::remove(file_name.c_str());
+   }
+   MPI_Barrier(comm);
+}
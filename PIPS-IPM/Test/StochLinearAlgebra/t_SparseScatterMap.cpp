@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include "SparseStorage.h"
+
+#include <random>
+#include <set>
+#include <vector>
+
+/* the sparse Schur complement assembly maps once where the rows of a border block land in the complement and afterwards only scatters -
+ * that has to add the same values as multMatSymUpper, which searches the complement row for every product */
+class SparseScatterMapTest : public ::testing::TestWithParam<int> {
+protected:
+   static constexpr int m = 6;
+   static constexpr int n = 5;
+   static constexpr int n_res = 10;
+
+   /* rows 2 and 4 of the border block are empty */
+   std::vector<int> krowM{0, 2, 4, 4, 5, 5, 8};
+   std::vector<int> jcolM{0, 3, 1, 2, 4, 0, 2, 4};
+   std::vector<double> M{1.5, -2.0, 0.5, 3.0, -1.0, 2.5, -0.5, 1.0};
+
+   std::vector<int> krowM_res;
+   std::vector<int> jcolM_res;
+   std::vector<double> M_res;
+
+   /* upper triangle of the complement - the columns that only the empty border rows would add to are missing, as in the symbolic pattern */
+   void createResultPattern(int ycolstart) {
+      const std::set<int> missing{ycolstart + 2, ycolstart + 4};
+      std::mt19937 generator(4711);
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+      krowM_res = {0};
+      for (int row = 0; row < n_res; ++row) {
+         for (int col = row; col < n_res; ++col) {
+            if (missing.count(col) && col != row)
+               continue;
+            jcolM_res.push_back(col);
+            M_res.push_back(distribution(generator));
+         }
+         krowM_res.push_back(static_cast<int>(jcolM_res.size()));
+      }
+   }
+
+   static std::vector<double> x(int seed) {
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+      std::vector<double> x(n);
+      for (double& xi : x)
+         xi = distribution(generator);
+      return x;
+   }
+};
+
+TEST_P(SparseScatterMapTest, ScatteredProductsMatchMultMatSymUpper) {
+   const int ycolstart = GetParam();
+   createResultPattern(ycolstart);
+
+   const SparseStorage border(m, n, static_cast<int>(jcolM.size()), krowM.data(), jcolM.data(), M.data());
+   const int nnz_res = static_cast<int>(jcolM_res.size());
+
+   std::vector<double> M_searched = M_res;
+   std::vector<double> M_scattered = M_res;
+   SparseStorage res_searched(n_res, n_res, nnz_res, krowM_res.data(), jcolM_res.data(), M_searched.data());
+   const SparseStorage res_pattern(n_res, n_res, nnz_res, krowM_res.data(), jcolM_res.data(), M_res.data());
+
+   std::vector<std::vector<int>> rows(n_res);
+   std::vector<std::vector<int>> positions(n_res);
+   for (int row = 0; row < n_res; ++row)
+      border.symUpperScatterMap(res_pattern, row, ycolstart, rows[row], positions[row]);
+
+   /* the maps are reused for several products */
+   for (int seed : {1, 2, 3}) {
+      const std::vector<double> col = x(seed);
+      for (int row = 0; row < n_res; ++row) {
+         border.multMatSymUpper(1.0, res_searched, -1.0, col.data(), row, ycolstart);
+         border.multMatSymUpperScattered(M_scattered.data(), -1.0, col.data(), rows[row], positions[row]);
+      }
+
+      for (int i = 0; i < nnz_res; ++i)
+         EXPECT_DOUBLE_EQ(M_scattered[i], M_searched[i]) << " entry " << i << " after x" << seed;
+   }
+
+   /* nothing lands below the diagonal or on the columns of the empty rows */
+   for (int row = 0; row < n_res; ++row) {
+      for (size_t i = 0; i < rows[row].size(); ++i) {
+         const int col_res = jcolM_res[positions[row][i]];
+         EXPECT_GE(col_res, row);
+         EXPECT_EQ(col_res, rows[row][i] + ycolstart);
+         EXPECT_NE(krowM[rows[row][i]], krowM[rows[row][i] + 1]);
+      }
+   }
+}
+
+INSTANTIATE_TEST_SUITE_P(SparseScatterMapColumnOffsets, SparseScatterMapTest, ::testing::Values(0, 2, 4));